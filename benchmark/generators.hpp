@@ -0,0 +1,95 @@
+#ifndef GDWG_BENCHMARK_GENERATORS_HPP
+#define GDWG_BENCHMARK_GENERATORS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+/*
+Synthetic graphs shared by the benchmarks.
+Every generator is seeded, so runs are repeatable.
+*/
+namespace gdwg::bench {
+	/*
+	A side x side grid with two-way roads between neighbouring
+	intersections, standing in for a road network: sparse, near-planar,
+	average degree close to four and a large diameter.
+	*/
+	inline auto road_grid(int side) -> graph<int, double> {
+		auto g = graph<int, double>{};
+		for (auto i = 0; i < side * side; ++i) {
+			g.insert_node(i);
+		}
+		auto rng = std::mt19937_64(static_cast<std::uint64_t>(side));
+		auto length = std::uniform_real_distribution<double>(1.0, 100.0);
+		for (auto r = 0; r < side; ++r) {
+			for (auto c = 0; c < side; ++c) {
+				auto const u = r * side + c;
+				if (c + 1 < side) {
+					g.insert_edge(u, u + 1, length(rng));
+					g.insert_edge(u + 1, u, length(rng));
+				}
+				if (r + 1 < side) {
+					g.insert_edge(u, u + side, length(rng));
+					g.insert_edge(u + side, u, length(rng));
+				}
+			}
+		}
+		return g;
+	}
+
+	/*
+	R-MAT graph with 2^scale nodes and about edge_factor * 2^scale
+	edges, using the Graph500 quadrant probabilities (0.57, 0.19, 0.19).
+	Gives the skewed, small-diameter degree distribution of social
+	and web graphs. Every edge has weight 1, so a repeated draw of the
+	same edge is dropped by insert_edge and the graph has somewhat fewer
+	edges than drawn.
+	*/
+	inline auto rmat(int scale, int edge_factor) -> graph<int, double> {
+		auto const n = 1 << scale;
+		auto g = graph<int, double>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		auto rng = std::mt19937_64(static_cast<std::uint64_t>(scale) * 31 + static_cast<std::uint64_t>(edge_factor));
+		auto coin = std::uniform_real_distribution<double>(0.0, 1.0);
+		auto const edges = static_cast<std::int64_t>(n) * edge_factor;
+		for (auto e = std::int64_t{0}; e < edges; ++e) {
+			auto src = 0;
+			auto dst = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const p = coin(rng);
+				auto const right = p >= 0.57 && (p < 0.76 || p >= 0.95);
+				auto const down = p >= 0.76;
+				src |= (down ? 1 : 0) << bit;
+				dst |= (right ? 1 : 0) << bit;
+			}
+			g.insert_edge(src, dst, 1.0);
+		}
+		return g;
+	}
+
+	/*
+	R-MAT graph with every edge turned to point from the larger node to
+	the smaller, like a citation network: acyclic, with the skewed
+	degrees of rmat. Self-loops are dropped.
+	*/
+	inline auto rmat_dag(int scale, int edge_factor) -> graph<int, double> {
+		auto const source = rmat(scale, edge_factor);
+		auto g = graph<int, double>{};
+		for (auto const v : source.nodes()) {
+			g.insert_node(v);
+		}
+		for (auto const& [from, to, weight] : source) {
+			if (from != to) {
+				g.insert_edge(std::max(from, to), std::min(from, to), weight);
+			}
+		}
+		return g;
+	}
+} // namespace gdwg::bench
+
+#endif // GDWG_BENCHMARK_GENERATORS_HPP
@@ -0,0 +1,56 @@
+#include "generators.hpp"
+
+#include "gdwg/bfs.hpp"
+#include "gdwg/csr.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace {
+	// What callers wrote before gdwg::bfs: a queue over connections()
+	auto naive_bfs(gdwg::graph<int, double> const& g, int src) -> std::vector<std::uint32_t> {
+		auto dist = std::vector<std::uint32_t>(g.nodes().size(), UINT32_MAX);
+		auto queue = std::deque<int>{src};
+		dist[static_cast<std::size_t>(src)] = 0;
+		while (!queue.empty()) {
+			auto const u = queue.front();
+			queue.pop_front();
+			for (auto const v : g.connections(u)) {
+				if (dist[static_cast<std::size_t>(v)] == UINT32_MAX) {
+					dist[static_cast<std::size_t>(v)] = dist[static_cast<std::size_t>(u)] + 1;
+					queue.push_back(v);
+				}
+			}
+		}
+		return dist;
+	}
+
+	void bench_naive(benchmark::State& state) {
+		auto const g = gdwg::bench::rmat(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(naive_bfs(g, 0));
+		}
+	}
+
+	// Arguments are scale, edge factor and threads (0 for every core)
+	void bench_bfs(benchmark::State& state) {
+		auto const g = gdwg::csr(
+		   gdwg::bench::rmat(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+		auto const reverse = g.transpose();
+		auto const threads = static_cast<std::size_t>(state.range(2));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::bfs(g, reverse, 0, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+} // namespace
+
+BENCHMARK(bench_naive)->Args({10, 16})->Args({12, 16})->Unit(benchmark::kMillisecond);
+// The largest sizes (up to ~100M edges) need tens of GB for the graph itself
+BENCHMARK(bench_bfs)
+   ->ArgsProduct({{14, 18}, {16}, {1, 0}})
+   ->Args({22, 16, 0})
+   ->Args({23, 12, 0})
+   ->Unit(benchmark::kMillisecond);
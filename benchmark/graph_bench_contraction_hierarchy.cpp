@@ -0,0 +1,76 @@
+#include "generators.hpp"
+
+#include "gdwg/contraction_hierarchy.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/point_to_point.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Random query pairs, the same for every benchmark of one size
+	auto queries(std::size_t n) -> std::vector<std::pair<gdwg::node_id, gdwg::node_id>> {
+		auto rng = std::mt19937_64(n);
+		auto node = std::uniform_int_distribution<gdwg::node_id>(0, static_cast<gdwg::node_id>(n - 1));
+		auto ret = std::vector<std::pair<gdwg::node_id, gdwg::node_id>>(1024);
+		for (auto& [src, dst] : ret) {
+			src = node(rng);
+			dst = node(rng);
+		}
+		return ret;
+	}
+
+	void bench_preprocess(benchmark::State& state) {
+		auto const g = gdwg::csr(gdwg::bench::road_grid(static_cast<int>(state.range(0))));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::contraction_hierarchy(g));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.size()));
+	}
+
+	void bench_load(benchmark::State& state) {
+		auto const g = gdwg::csr(gdwg::bench::road_grid(static_cast<int>(state.range(0))));
+		auto saved = std::stringstream{};
+		gdwg::contraction_hierarchy(g).save(saved);
+		auto const bytes = saved.str();
+		for (auto _ : state) {
+			auto is = std::istringstream{bytes};
+			benchmark::DoNotOptimize(gdwg::contraction_hierarchy<double>::load(is));
+		}
+		state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+	}
+
+	// The fastest query without preprocessing, as the baseline
+	void bench_bidirectional_dijkstra(benchmark::State& state) {
+		auto const g = gdwg::csr(gdwg::bench::road_grid(static_cast<int>(state.range(0))));
+		auto const reverse = g.transpose();
+		auto const pairs = queries(g.size());
+		auto ws = gdwg::path_workspace<double>(g.size());
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const [src, dst] = pairs[i++ % pairs.size()];
+			benchmark::DoNotOptimize(gdwg::bidirectional_dijkstra(g, reverse, src, dst, ws));
+		}
+	}
+
+	void bench_query(benchmark::State& state) {
+		auto const g = gdwg::csr(gdwg::bench::road_grid(static_cast<int>(state.range(0))));
+		auto const ch = gdwg::contraction_hierarchy(g);
+		auto const pairs = queries(g.size());
+		auto ws = gdwg::contraction_hierarchy<double>::workspace{};
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const [src, dst] = pairs[i++ % pairs.size()];
+			benchmark::DoNotOptimize(ch.distance(src, dst, ws));
+		}
+	}
+} // namespace
+
+BENCHMARK(bench_preprocess)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_load)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_bidirectional_dijkstra)->Arg(64)->Arg(128)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bench_query)->Arg(64)->Arg(128)->Unit(benchmark::kMicrosecond);
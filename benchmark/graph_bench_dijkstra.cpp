@@ -0,0 +1,79 @@
+#include "generators.hpp"
+
+#include "gdwg/csr.hpp"
+#include "gdwg/dijkstra.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+	// What callers wrote before gdwg::dijkstra: a search on top of
+	// connections() and weights() copies, keyed by node value.
+	auto naive_dijkstra(gdwg::graph<int, double> const& g, int src) -> std::map<int, double> {
+		auto dist = std::map<int, double>{{src, 0.0}};
+		using entry = std::pair<double, int>;
+		auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>();
+		queue.emplace(0.0, src);
+		while (!queue.empty()) {
+			auto const [d, u] = queue.top();
+			queue.pop();
+			if (d > dist[u]) {
+				continue;
+			}
+			auto connections = g.connections(u);
+			connections.erase(std::unique(connections.begin(), connections.end()), connections.end());
+			for (auto const v : connections) {
+				auto const w = g.weights(u, v).front();
+				auto const it = dist.find(v);
+				if (it == dist.end() || d + w < it->second) {
+					dist[v] = d + w;
+					queue.emplace(d + w, v);
+				}
+			}
+		}
+		return dist;
+	}
+
+	void bench_naive(benchmark::State& state) {
+		auto const g = gdwg::bench::road_grid(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(naive_dijkstra(g, 0));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+	}
+
+	void bench_csr_build(benchmark::State& state) {
+		auto const g = gdwg::bench::road_grid(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::csr(g));
+		}
+	}
+
+	void bench_single_source(benchmark::State& state) {
+		auto const g = gdwg::csr(gdwg::bench::road_grid(static_cast<int>(state.range(0))));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::dijkstra(g, 0));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.size()));
+	}
+
+	// Corner to centre, so early exit settles about half the graph
+	void bench_point_to_point(benchmark::State& state) {
+		auto const side = static_cast<int>(state.range(0));
+		auto const g = gdwg::csr(gdwg::bench::road_grid(side));
+		auto const target = static_cast<gdwg::node_id>(g.id((side / 2) * side + side / 2));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::dijkstra(g, 0, target));
+		}
+	}
+} // namespace
+
+BENCHMARK(bench_naive)->Arg(32)->Arg(64)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_csr_build)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_single_source)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_point_to_point)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
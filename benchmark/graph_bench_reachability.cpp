@@ -0,0 +1,85 @@
+#include "generators.hpp"
+
+#include "gdwg/csr.hpp"
+#include "gdwg/reachability.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+	// What callers wrote before gdwg::reachability_index: a DFS over connections()
+	auto naive_is_reachable(gdwg::graph<int, double> const& g, int src, int dst) -> bool {
+		auto seen = std::vector<bool>(g.nodes().size(), false);
+		auto stack = std::vector<int>{src};
+		seen[static_cast<std::size_t>(src)] = true;
+		while (!stack.empty()) {
+			auto const u = stack.back();
+			stack.pop_back();
+			if (u == dst) {
+				return true;
+			}
+			for (auto const v : g.connections(u)) {
+				if (!seen[static_cast<std::size_t>(v)]) {
+					seen[static_cast<std::size_t>(v)] = true;
+					stack.push_back(v);
+				}
+			}
+		}
+		return false;
+	}
+
+	// Random query pairs, the same for every benchmark of one size
+	auto queries(std::size_t n) -> std::vector<std::pair<gdwg::node_id, gdwg::node_id>> {
+		auto rng = std::mt19937_64(n);
+		auto node = std::uniform_int_distribution<gdwg::node_id>(0, static_cast<gdwg::node_id>(n - 1));
+		auto ret = std::vector<std::pair<gdwg::node_id, gdwg::node_id>>(4096);
+		for (auto& [src, dst] : ret) {
+			src = node(rng);
+			dst = node(rng);
+		}
+		return ret;
+	}
+
+	void bench_naive(benchmark::State& state) {
+		auto const g = gdwg::bench::rmat_dag(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+		auto const pairs = queries(g.nodes().size());
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const [src, dst] = pairs[i++ % pairs.size()];
+			benchmark::DoNotOptimize(naive_is_reachable(g, static_cast<int>(src), static_cast<int>(dst)));
+		}
+	}
+
+	// Arguments are scale and edge factor; reports the index size
+	void bench_build(benchmark::State& state) {
+		auto const g = gdwg::csr(
+		   gdwg::bench::rmat_dag(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+		auto index = gdwg::reachability_index{};
+		for (auto _ : state) {
+			index = gdwg::reachability_index(g);
+			benchmark::DoNotOptimize(index);
+		}
+		state.counters["labels_per_node"] = static_cast<double>(index.num_labels()) / static_cast<double>(g.size());
+		state.counters["index_bytes"] = static_cast<double>(index.bytes());
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+
+	void bench_query(benchmark::State& state) {
+		auto const g = gdwg::csr(
+		   gdwg::bench::rmat_dag(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+		auto const index = gdwg::reachability_index(g);
+		auto const pairs = queries(g.size());
+		auto i = std::size_t{0};
+		for (auto _ : state) {
+			auto const [src, dst] = pairs[i++ % pairs.size()];
+			benchmark::DoNotOptimize(index.is_reachable(src, dst));
+		}
+	}
+} // namespace
+
+BENCHMARK(bench_naive)->Args({12, 8})->Unit(benchmark::kMicrosecond);
+BENCHMARK(bench_build)->ArgsProduct({{12, 14, 16}, {8}})->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_query)->ArgsProduct({{12, 14, 16}, {8}})->Unit(benchmark::kNanosecond);
@@ -0,0 +1,68 @@
+#include "generators.hpp"
+
+#include "gdwg/csr.hpp"
+#include "gdwg/triangles.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace {
+	// What callers wrote before gdwg::triangle_count: neighbour sets from connections()
+	auto naive_triangles(gdwg::graph<int, double> const& g) -> std::uint64_t {
+		auto const nodes = g.nodes();
+		auto neighbours = std::vector<std::vector<int>>(nodes.size());
+		for (auto const u : nodes) {
+			for (auto const v : g.connections(u)) {
+				if (u != v) {
+					neighbours[static_cast<std::size_t>(u)].push_back(v);
+					neighbours[static_cast<std::size_t>(v)].push_back(u);
+				}
+			}
+		}
+		for (auto& list : neighbours) {
+			std::sort(list.begin(), list.end());
+			list.erase(std::unique(list.begin(), list.end()), list.end());
+		}
+		auto total = std::uint64_t{0};
+		for (auto const u : nodes) {
+			for (auto const v : neighbours[static_cast<std::size_t>(u)]) {
+				if (v <= u) {
+					continue;
+				}
+				auto common = std::vector<int>{};
+				auto const& a = neighbours[static_cast<std::size_t>(u)];
+				auto const& b = neighbours[static_cast<std::size_t>(v)];
+				std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+				total += static_cast<std::uint64_t>(std::count_if(common.begin(), common.end(), [v](int w) {
+					return w > v;
+				}));
+			}
+		}
+		return total;
+	}
+
+	void bench_naive(benchmark::State& state) {
+		auto const g = gdwg::bench::rmat(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(naive_triangles(g));
+		}
+	}
+
+	// Arguments are scale, edge factor and threads (0 for every core)
+	void bench_triangle_count(benchmark::State& state) {
+		auto const g = gdwg::csr(
+		   gdwg::bench::rmat(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+		auto const reverse = g.transpose();
+		auto const threads = static_cast<std::size_t>(state.range(2));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::triangle_count(g, reverse, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+} // namespace
+
+BENCHMARK(bench_naive)->Args({12, 16})->Args({14, 16})->Unit(benchmark::kMillisecond);
+BENCHMARK(bench_triangle_count)->ArgsProduct({{12, 14, 18}, {16}, {1, 0}})->Unit(benchmark::kMillisecond);
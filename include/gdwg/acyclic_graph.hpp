@@ -0,0 +1,208 @@
+#ifndef GDWG_ACYCLIC_GRAPH_HPP
+#define GDWG_ACYCLIC_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	/*
+	A graph that stays acyclic. It keeps a topological order of its
+	nodes up to date as edges are inserted (Pearce-Kelly), so an edge
+	that would close a cycle is rejected without sorting the whole
+	graph again. An edge src->dst that already agrees with the order
+	costs O(log(n)); otherwise only nodes ordered between dst and src
+	that are reachable from dst, or reach src, are searched and
+	reordered among themselves.
+	*/
+	template<typename N, typename E>
+	class acyclic_graph {
+	public:
+		acyclic_graph() = default;
+
+		// Modifiers
+		/*
+		Insert a node, placed last in the topological order.
+		If that given node exist, return false
+		*/
+		auto insert_node(N const& value) -> bool {
+			if (!graph_.insert_node(value)) {
+				return false;
+			}
+			auto const v = values_.size();
+			index_.emplace(value, v);
+			values_.push_back(value);
+			order_.push_back(v);
+			at_.push_back(v);
+			out_.emplace_back();
+			in_.emplace_back();
+			mark_.push_back(false);
+			return true;
+		}
+
+		/*
+		Insert the edge src->dst with the given weight, reordering
+		nodes if needed. Return false, leaving everything unchanged, if
+		the edge already exists or would create a cycle (including a
+		self-loop).
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::acyclic_graph<N, E>::insert_edge when either src or dst node does not exist";
+				throw std::runtime_error(error_msg);
+			}
+			auto const x = index_.find(src)->second;
+			auto const y = index_.find(dst)->second;
+			if (x == y || (order_[y] < order_[x] && !reorder(x, y))) {
+				return false;
+			}
+			if (!graph_.insert_edge(src, dst, weight)) {
+				return false;
+			}
+			out_[x].push_back(y);
+			in_[y].push_back(x);
+			return true;
+		}
+
+		/*
+		Erase the edge src->dst with the given weight. The current
+		order stays valid, so nothing is reordered.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::acyclic_graph<N, E>::erase_edge on src or dst if they don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			if (!graph_.erase_edge(src, dst, weight)) {
+				return false;
+			}
+			auto const x = index_.find(src)->second;
+			auto const y = index_.find(dst)->second;
+			out_[x].erase(std::find(out_[x].begin(), out_[x].end(), y));
+			in_[y].erase(std::find(in_[y].begin(), in_[y].end(), x));
+			return true;
+		}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return graph_.is_node(value);
+		}
+
+		// The underlying graph, for everything else that reads a graph
+		[[nodiscard]] auto graph() const noexcept -> gdwg::graph<N, E> const& {
+			return graph_;
+		}
+
+		/*
+		Nodes ordered so that every edge goes from an earlier node to
+		a later one.
+		Time Complexity : O(n)
+		*/
+		[[nodiscard]] auto topological_order() const -> std::vector<N> {
+			auto ret = std::vector<N>{};
+			ret.reserve(at_.size());
+			for (auto const v : at_) {
+				ret.push_back(values_[v]);
+			}
+			return ret;
+		}
+
+		/*
+		Return true if src comes before dst in the current order.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		[[nodiscard]] auto precedes(N const& src, N const& dst) const -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::acyclic_graph<N, E>::precedes if src or dst node don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			return order_[index_.find(src)->second] < order_[index_.find(dst)->second];
+		}
+
+	private:
+		gdwg::graph<N, E> graph_;
+		std::map<N, std::size_t> index_;
+		// Everything below is indexed by insertion index
+		std::vector<N> values_;
+		// Position of each node in the order
+		std::vector<std::size_t> order_;
+		// Node at each position of the order
+		std::vector<std::size_t> at_;
+		// One entry per edge, so parallel edges appear more than once
+		std::vector<std::vector<std::size_t>> out_;
+		std::vector<std::vector<std::size_t>> in_;
+		std::vector<bool> mark_;
+
+		/*
+		Restore the order for a new edge x->y with y currently before x.
+		Search forward from y and backward from x, only among nodes
+		between them in the order, then give the nodes found backward
+		followed by those found forward the positions they held between
+		them. Return false, changing nothing, if x is reachable from y.
+		*/
+		auto reorder(std::size_t x, std::size_t y) -> bool {
+			auto const lower = order_[y];
+			auto const upper = order_[x];
+			auto forward = std::vector<std::size_t>{};
+			auto backward = std::vector<std::size_t>{};
+			auto const search = [this](std::size_t start, auto const& adjacency, auto inside, auto& found) {
+				found.push_back(start);
+				mark_[start] = true;
+				for (auto i = std::size_t{0}; i < found.size(); ++i) {
+					for (auto const w : adjacency[found[i]]) {
+						if (!mark_[w] && inside(order_[w])) {
+							mark_[w] = true;
+							found.push_back(w);
+						}
+					}
+				}
+			};
+			auto const unmark = [this](std::vector<std::size_t> const& nodes) {
+				for (auto const v : nodes) {
+					mark_[v] = false;
+				}
+			};
+
+			search(y, out_, [upper](std::size_t pos) { return pos <= upper; }, forward);
+			if (mark_[x]) {
+				unmark(forward);
+				return false;
+			}
+			search(x, in_, [lower](std::size_t pos) { return lower < pos; }, backward);
+			unmark(forward);
+			unmark(backward);
+
+			auto const by_order = [this](std::size_t a, std::size_t b) { return order_[a] < order_[b]; };
+			std::sort(forward.begin(), forward.end(), by_order);
+			std::sort(backward.begin(), backward.end(), by_order);
+			auto positions = std::vector<std::size_t>{};
+			positions.reserve(forward.size() + backward.size());
+			for (auto const v : backward) {
+				positions.push_back(order_[v]);
+			}
+			for (auto const v : forward) {
+				positions.push_back(order_[v]);
+			}
+			std::sort(positions.begin(), positions.end());
+			auto next = positions.begin();
+			auto const place = [this, &next](std::vector<std::size_t> const& part) {
+				for (auto const v : part) {
+					order_[v] = *next;
+					at_[*next] = v;
+					++next;
+				}
+			};
+			place(backward);
+			place(forward);
+			return true;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_ACYCLIC_GRAPH_HPP
@@ -0,0 +1,312 @@
+#ifndef GDWG_ARBORESCENCE_HPP
+#define GDWG_ARBORESCENCE_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/*
+	A spanning arborescence indexed by node id: parent[v] is the
+	source of the edge chosen into v and weight[v] its weight.
+	The root is its own parent, and nodes the root cannot reach
+	have no_node as parent.
+	*/
+	template<typename E>
+	struct arborescence {
+		std::vector<node_id> parent;
+		std::vector<E> weight;
+		E total{};
+	};
+
+	namespace detail {
+		/*
+		Leftist heaps of edges kept in one pool, with a lazy amount
+		added to every key below a node, so a whole heap can have its
+		keys lowered in O(1) and two heaps merge in O(log(n)).
+		*/
+		template<typename E>
+		class leftist_heaps {
+		public:
+			static constexpr auto none = static_cast<std::size_t>(-1);
+
+			// Make a one element heap and return it
+			auto make(E const& key, std::size_t value) -> std::size_t {
+				nodes_.push_back({key, E{}, value, none, none, 1});
+				return nodes_.size() - 1;
+			}
+
+			// Key and value of the smallest element of non-empty heap h
+			auto top(std::size_t h) -> std::pair<E, std::size_t> {
+				push_down(h);
+				return {nodes_[h].key, nodes_[h].value};
+			}
+
+			// Add delta to every key in heap h
+			auto add(std::size_t h, E const& delta) -> void {
+				nodes_[h].delta += delta;
+			}
+
+			// Remove the smallest element of non-empty heap h and return the rest
+			auto pop(std::size_t h) -> std::size_t {
+				push_down(h);
+				return merge(nodes_[h].left, nodes_[h].right);
+			}
+
+			auto merge(std::size_t a, std::size_t b) -> std::size_t {
+				if (a == none || b == none) {
+					return a == none ? b : a;
+				}
+				push_down(a);
+				push_down(b);
+				if (nodes_[b].key < nodes_[a].key) {
+					std::swap(a, b);
+				}
+				// Recursion only follows right spines, which are O(log(n)) long
+				auto const right = merge(nodes_[a].right, b);
+				nodes_[a].right = right;
+				if (rank(nodes_[a].left) < rank(right)) {
+					std::swap(nodes_[a].left, nodes_[a].right);
+				}
+				nodes_[a].rank = rank(nodes_[a].right) + 1;
+				return a;
+			}
+
+		private:
+			struct node {
+				E key;
+				E delta;
+				std::size_t value;
+				std::size_t left;
+				std::size_t right;
+				std::size_t rank;
+			};
+
+			std::vector<node> nodes_;
+
+			[[nodiscard]] auto rank(std::size_t h) const -> std::size_t {
+				return h == none ? 0 : nodes_[h].rank;
+			}
+
+			auto push_down(std::size_t h) -> void {
+				auto& x = nodes_[h];
+				if (x.delta == E{}) {
+					return;
+				}
+				x.key += x.delta;
+				for (auto const child : {x.left, x.right}) {
+					if (child != none) {
+						nodes_[child].delta += x.delta;
+					}
+				}
+				x.delta = E{};
+			}
+		};
+
+		// Union-find without path compression, so unions can be undone
+		class rollback_union_find {
+		public:
+			explicit rollback_union_find(std::size_t n)
+			: parent_(n)
+			, size_(n, 1) {
+				for (auto v = node_id{0}; v < n; ++v) {
+					parent_[v] = v;
+				}
+			}
+
+			[[nodiscard]] auto find(node_id v) const -> node_id {
+				while (parent_[v] != v) {
+					v = parent_[v];
+				}
+				return v;
+			}
+
+			// Return false if a and b were already in the same set
+			auto unite(node_id a, node_id b) -> bool {
+				a = find(a);
+				b = find(b);
+				if (a == b) {
+					return false;
+				}
+				if (size_[a] < size_[b]) {
+					std::swap(a, b);
+				}
+				parent_[b] = a;
+				size_[a] += size_[b];
+				history_.push_back(b);
+				return true;
+			}
+
+			[[nodiscard]] auto time() const noexcept -> std::size_t {
+				return history_.size();
+			}
+
+			// Undo every union made after time t
+			auto rollback(std::size_t t) -> void {
+				while (history_.size() > t) {
+					auto const b = history_.back();
+					history_.pop_back();
+					size_[parent_[b]] -= size_[b];
+					parent_[b] = b;
+				}
+			}
+
+		private:
+			std::vector<node_id> parent_;
+			std::vector<std::size_t> size_;
+			std::vector<node_id> history_;
+		};
+	} // namespace detail
+
+	/*
+	Minimum weight spanning arborescence rooted at root, over the nodes
+	root can reach, by Tarjan's version of Edmonds' algorithm.
+	Each node keeps its incoming edges in a mergeable heap. Following
+	the cheapest edge backwards either reaches a finished part or
+	closes a cycle, which is contracted by merging its heaps after
+	lowering each by the weight of the edge already chosen inside the
+	cycle. The chosen edges are recovered afterwards by undoing the
+	contractions in reverse order.
+	Negative weights are allowed; self-loops and edges into the root
+	are never chosen.
+	Time Complexity : O(e log(n))
+	*/
+	template<typename N, typename E>
+	auto min_arborescence(csr<N, E> const& g, node_id root) -> arborescence<E> {
+		auto const n = g.size();
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto const& weights = g.weights();
+
+		// Nodes root can reach, in breadth-first order
+		auto reached = std::vector<node_id>{root};
+		auto is_reached = std::vector<bool>(n, false);
+		is_reached[root] = true;
+		for (auto i = std::size_t{0}; i < reached.size(); ++i) {
+			for (auto const v : g.neighbours(reached[i])) {
+				if (!is_reached[v]) {
+					is_reached[v] = true;
+					reached.push_back(v);
+				}
+			}
+		}
+
+		// Heap values are edge positions in targets() and weights()
+		auto source = std::vector<node_id>(targets.size());
+		auto heaps = detail::leftist_heaps<E>{};
+		auto heap = std::vector<std::size_t>(n, heaps.none);
+		for (auto const u : reached) {
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+				source[k] = u;
+				auto const v = targets[k];
+				if (v != u && v != root) {
+					heap[v] = heaps.merge(heap[v], heaps.make(weights[k], k));
+				}
+			}
+		}
+
+		struct contraction {
+			node_id node;
+			std::size_t time;
+			std::vector<std::size_t> edges;
+		};
+
+		auto sets = detail::rollback_union_find(n);
+		auto seen = std::vector<node_id>(n, no_node);
+		auto path = std::vector<node_id>(n);
+		auto queue = std::vector<std::size_t>(n);
+		auto in = std::vector<std::size_t>(n, heaps.none);
+		auto contractions = std::vector<contraction>{};
+		seen[root] = root;
+		for (auto const s : reached) {
+			auto u = s;
+			auto length = std::size_t{0};
+			while (seen[u] == no_node) {
+				auto const [w, k] = heaps.top(heap[u]);
+				heaps.add(heap[u], -w);
+				heap[u] = heaps.pop(heap[u]);
+				queue[length] = k;
+				path[length++] = u;
+				seen[u] = s;
+				u = sets.find(source[k]);
+				if (seen[u] != s) {
+					continue;
+				}
+				// Contract the cycle just closed into a single node
+				auto merged = heaps.none;
+				auto const end = length;
+				auto const time = sets.time();
+				auto member = no_node;
+				do {
+					member = path[--length];
+					merged = heaps.merge(merged, heap[member]);
+				} while (sets.unite(u, member));
+				u = sets.find(u);
+				heap[u] = merged;
+				seen[u] = no_node;
+				contractions.push_back({u, time, {queue.begin() + static_cast<std::ptrdiff_t>(length),
+				                                  queue.begin() + static_cast<std::ptrdiff_t>(end)}});
+			}
+			for (auto i = std::size_t{0}; i < length; ++i) {
+				in[sets.find(targets[queue[i]])] = queue[i];
+			}
+		}
+
+		// Expand the cycles again: each keeps its edges but the one
+		// replaced by the edge chosen into the whole cycle
+		for (auto c = contractions.rbegin(); c != contractions.rend(); ++c) {
+			sets.rollback(c->time);
+			auto const entry = in[c->node];
+			for (auto const k : c->edges) {
+				in[sets.find(targets[k])] = k;
+			}
+			in[sets.find(targets[entry])] = entry;
+		}
+
+		auto ret = arborescence<E>{std::vector<node_id>(n, no_node), std::vector<E>(n, E{}), E{}};
+		ret.parent[root] = root;
+		for (auto const v : reached) {
+			if (v != root) {
+				ret.parent[v] = source[in[v]];
+				ret.weight[v] = weights[in[v]];
+				ret.total += weights[in[v]];
+			}
+		}
+		return ret;
+	}
+
+	/*
+	Edges of a minimum weight spanning arborescence of g rooted at
+	root, spanning the nodes root can reach, in the graph's edge order.
+	Throw runtime error if is_node(root) is false
+	*/
+	template<typename N, typename E>
+	auto min_arborescence(graph<N, E> const& g, N const& root) -> std::vector<typename graph<N, E>::value_type> {
+		if (!g.is_node(root)) {
+			auto error_msg = "Cannot call gdwg::min_arborescence if root doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		auto const tree = min_arborescence(snapshot, snapshot.id(root));
+		auto edges = std::vector<std::pair<node_id, node_id>>{};
+		for (auto v = node_id{0}; v < snapshot.size(); ++v) {
+			if (tree.parent[v] != no_node && tree.parent[v] != v) {
+				edges.emplace_back(tree.parent[v], v);
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		auto ret = std::vector<typename graph<N, E>::value_type>{};
+		ret.reserve(edges.size());
+		for (auto const& [u, v] : edges) {
+			ret.push_back({snapshot.node(u), snapshot.node(v), tree.weight[v]});
+		}
+		return ret;
+	}
+} // namespace gdwg
+
+#endif // GDWG_ARBORESCENCE_HPP
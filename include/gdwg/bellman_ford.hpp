@@ -0,0 +1,224 @@
+#ifndef GDWG_BELLMAN_FORD_HPP
+#define GDWG_BELLMAN_FORD_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Result of a shortest path search that allows negative weights.
+	If a negative cycle is reachable from the source, its nodes are
+	listed in edge order and paths only holds the distances reached
+	before the search stopped.
+	*/
+	template<typename E>
+	struct bellman_ford_result {
+		shortest_paths<E> paths;
+		std::vector<node_id> negative_cycle;
+
+		[[nodiscard]] auto has_negative_cycle() const -> bool {
+			return !negative_cycle.empty();
+		}
+	};
+
+	// One edge of a flat edge array
+	template<typename E>
+	struct flat_edge {
+		node_id from;
+		node_id to;
+		E weight;
+	};
+
+	namespace detail {
+		/*
+		The edges of g as one contiguous array ordered by source, so a
+		relaxation round is a single sequential scan.
+		*/
+		template<typename N, typename E>
+		auto edge_array(csr<N, E> const& g) -> std::vector<flat_edge<E>> {
+			auto ret = std::vector<flat_edge<E>>{};
+			ret.reserve(g.num_edges());
+			for (auto u = node_id{0}; u < g.size(); ++u) {
+				auto const targets = g.neighbours(u);
+				auto const weights = g.weights(u);
+				for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+					ret.push_back({u, targets[k], weights[k]});
+				}
+			}
+			return ret;
+		}
+
+		/*
+		Find a cycle in the predecessor graph of paths and return it in
+		edge order, or an empty vector if there is none. Any such cycle
+		has negative total weight. The source is its own predecessor,
+		which only counts as a cycle once its distance went negative.
+		Time Complexity : O(n)
+		*/
+		template<typename E>
+		auto predecessor_cycle(shortest_paths<E> const& paths, node_id src) -> std::vector<node_id> {
+			auto const& pred = paths.predecessor;
+			auto const n = pred.size();
+			auto walk = std::vector<std::size_t>(n, 0);
+			auto const is_root = [&paths, &pred, src](node_id v) {
+				return v == src && pred[v] == v && !(paths.distance[src] < E{});
+			};
+			for (auto s = node_id{0}; s < n; ++s) {
+				// Follow predecessors until reaching the root, an unreached
+				// node, or a node some walk has already visited
+				auto v = s;
+				while (pred[v] != no_node && walk[v] == 0 && !is_root(v)) {
+					walk[v] = s + 1;
+					v = pred[v];
+				}
+				// Only coming back to a node of this walk closes a cycle
+				if (pred[v] == no_node || walk[v] != s + 1) {
+					continue;
+				}
+				auto ret = std::vector<node_id>{v};
+				for (auto u = pred[v]; u != v; u = pred[u]) {
+					ret.push_back(u);
+				}
+				std::reverse(ret.begin(), ret.end());
+				return ret;
+			}
+			return {};
+		}
+
+		/*
+		Bellman-Ford rounds over edges starting from the distances
+		already in paths. Stops early after a round with no change.
+		Return a node whose distance still changed in round n (so a
+		negative cycle exists), or no_node.
+		*/
+		template<typename E>
+		auto bellman_ford_rounds(std::vector<flat_edge<E>> const& edges, shortest_paths<E>& paths) -> node_id {
+			auto const n = paths.distance.size();
+			auto& dist = paths.distance;
+			for (auto round = std::size_t{0}; round < n; ++round) {
+				auto changed = no_node;
+				for (auto const& [u, v, w] : edges) {
+					if (dist[u] != infinity<E>() && dist[u] + w < dist[v]) {
+						dist[v] = dist[u] + w;
+						paths.predecessor[v] = u;
+						changed = v;
+					}
+				}
+				if (changed == no_node) {
+					return no_node;
+				}
+				if (round + 1 == n) {
+					return changed;
+				}
+			}
+			return no_node;
+		}
+	} // namespace detail
+
+	/*
+	Single-source shortest paths allowing negative weights.
+	Each round is one sequential scan of a flat edge array, and the
+	search stops after the first round that changes nothing.
+	Time Complexity : O(n*e), O(e) per round actually run
+	*/
+	template<typename N, typename E>
+	auto bellman_ford(csr<N, E> const& g, node_id src) -> bellman_ford_result<E> {
+		auto ret = bellman_ford_result<E>{
+		   {std::vector<E>(g.size(), detail::infinity<E>()), std::vector<node_id>(g.size(), no_node)},
+		   {}};
+		ret.paths.distance[src] = E{};
+		ret.paths.predecessor[src] = src;
+		auto const changed = detail::bellman_ford_rounds(detail::edge_array(g), ret.paths);
+		if (changed != no_node) {
+			ret.negative_cycle = detail::predecessor_cycle(ret.paths, src);
+		}
+		return ret;
+	}
+
+	/*
+	Queue-based Bellman-Ford (SPFA): only nodes whose distance just
+	changed have their edges relaxed again. Once a path reaches n edges
+	the predecessor graph is checked for the negative cycle that must
+	be forming, which is then reported.
+	Usually much faster than bellman_ford, with the same worst case.
+	*/
+	template<typename N, typename E>
+	auto spfa(csr<N, E> const& g, node_id src) -> bellman_ford_result<E> {
+		auto const n = g.size();
+		auto ret = bellman_ford_result<E>{
+		   {std::vector<E>(n, detail::infinity<E>()), std::vector<node_id>(n, no_node)},
+		   {}};
+		auto& dist = ret.paths.distance;
+		auto& pred = ret.paths.predecessor;
+		// Number of edges on the current path to each node
+		auto length = std::vector<std::size_t>(n, 0);
+		auto queued = std::vector<bool>(n, false);
+		auto queue = std::deque<node_id>{src};
+		dist[src] = E{};
+		pred[src] = src;
+		queued[src] = true;
+
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto const& weights = g.weights();
+		while (!queue.empty()) {
+			auto const u = queue.front();
+			queue.pop_front();
+			queued[u] = false;
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+				auto const v = targets[k];
+				if (dist[u] + weights[k] < dist[v]) {
+					dist[v] = dist[u] + weights[k];
+					pred[v] = u;
+					length[v] = length[u] + 1;
+					// Only check every n edges, so the O(n) search stays amortised
+					if (length[v] % n == 0) {
+						ret.negative_cycle = detail::predecessor_cycle(ret.paths, src);
+						if (!ret.negative_cycle.empty()) {
+							return ret;
+						}
+					}
+					if (!queued[v]) {
+						queued[v] = true;
+						queue.push_back(v);
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	/*
+	Convenience overloads over a graph.
+	Results are indexed by node id, i.e. by position in g.nodes().
+	Throw runtime error if is_node(src) is false
+	*/
+	template<typename N, typename E>
+	auto bellman_ford(graph<N, E> const& g, N const& src) -> bellman_ford_result<E> {
+		if (!g.is_node(src)) {
+			auto error_msg = "Cannot call gdwg::bellman_ford if src doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return bellman_ford(snapshot, snapshot.id(src));
+	}
+
+	template<typename N, typename E>
+	auto spfa(graph<N, E> const& g, N const& src) -> bellman_ford_result<E> {
+		if (!g.is_node(src)) {
+			auto error_msg = "Cannot call gdwg::spfa if src doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return spfa(snapshot, snapshot.id(src));
+	}
+} // namespace gdwg
+
+#endif // GDWG_BELLMAN_FORD_HPP
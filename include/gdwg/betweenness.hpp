@@ -0,0 +1,274 @@
+#ifndef GDWG_BETWEENNESS_HPP
+#define GDWG_BETWEENNESS_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	struct betweenness_options {
+		// Shortest paths by edge weight (Dijkstra) instead of hop count (BFS)
+		bool weighted = false;
+		// Number of sampled sources, or 0 to use every node exactly
+		std::size_t samples = 0;
+		// Probability that the reported error_bound holds
+		double confidence = 0.95;
+		std::uint64_t seed = 1;
+		// 0 means one per hardware thread
+		std::size_t threads = 0;
+	};
+
+	/*
+	Betweenness centrality indexed by node id: for every node v, the
+	sum over ordered pairs (s, t) with s != v != t of the fraction of
+	shortest s-t paths through v. Sampled results are scaled to
+	estimate the same quantity, and with probability at least the
+	requested confidence every node's estimate is within error_bound
+	of its exact value (error_bound is 0 when exact).
+	*/
+	struct betweenness_result {
+		std::vector<double> centrality;
+		std::size_t sources = 0;
+		double error_bound = 0;
+	};
+
+	namespace detail {
+		// Per thread state for single-source dependency accumulation
+		template<typename Distance>
+		struct brandes_workspace {
+			std::vector<Distance> distance;
+			std::vector<double> sigma;
+			std::vector<double> delta;
+			// Nodes in the order their distance became final
+			std::vector<node_id> order;
+			d_ary_heap<Distance> heap;
+			std::vector<double> centrality;
+
+			explicit brandes_workspace(std::size_t n)
+			: distance(n, infinity<Distance>())
+			, sigma(n, 0)
+			, delta(n, 0)
+			, heap(n)
+			, centrality(n, 0) {
+				order.reserve(n);
+			}
+
+			// Undo only what the last source touched
+			auto reset() -> void {
+				for (auto const v : order) {
+					distance[v] = infinity<Distance>();
+					sigma[v] = 0;
+					delta[v] = 0;
+				}
+				order.clear();
+			}
+
+			/*
+			Walk the nodes back from the farthest, handing each node's
+			dependency to its predecessors on shortest paths, which are
+			the u with an edge u->v where on_path(u, v, weight) holds.
+			*/
+			template<typename N, typename E, typename OnPath>
+			auto accumulate(csr<N, E> const& reverse, node_id s, OnPath on_path) -> void {
+				for (auto i = order.size(); i-- > 0;) {
+					auto const v = order[i];
+					auto const sources = reverse.neighbours(v);
+					auto const weights = reverse.weights(v);
+					auto const share = (1 + delta[v]) / sigma[v];
+					for (auto k = std::size_t{0}; k < sources.size(); ++k) {
+						if (on_path(sources[k], v, weights[k], k)) {
+							delta[sources[k]] += sigma[sources[k]] * share;
+						}
+					}
+					if (v != s) {
+						centrality[v] += delta[v];
+					}
+				}
+			}
+		};
+	} // namespace detail
+
+	/*
+	Betweenness centrality by Brandes' algorithm, with one
+	single-source search (BFS, or Dijkstra if options.weighted) per
+	source followed by a backward pass accumulating dependencies.
+	reverse must be g.transpose(); it supplies the predecessors in the
+	backward pass. Sources are taken by the threads one at a time, and
+	each thread sums into its own array, combined at the end.
+	With options.samples = k, only k distinct random sources are used
+	and the sums are scaled by n / k; error_bound then follows from
+	Hoeffding's inequality over the k samples, with a union bound over
+	all nodes.
+	Parallel edges count once when unweighted, and only the lightest
+	can lie on a shortest path when weighted. Weighted path counts
+	assume positive weights; a zero weight edge between two equally
+	distant nodes may be missed.
+	Throw runtime error if options.weighted is set and an edge has a
+	negative weight, or E is not arithmetic
+	Time Complexity : O(k*e) unweighted, O(k*(n+e)log(n)) weighted,
+	k being the number of sources
+	*/
+	template<typename N, typename E>
+	auto betweenness(csr<N, E> const& g, csr<N, E> const& reverse, betweenness_options const& options = {})
+	   -> betweenness_result {
+		auto const n = g.size();
+		auto sources = std::vector<node_id>(n);
+		std::iota(sources.begin(), sources.end(), node_id{0});
+		auto const sampled = options.samples != 0 && options.samples < n;
+		if (sampled) {
+			auto random = std::mt19937_64(options.seed);
+			// Partial Fisher-Yates shuffle picks distinct sources
+			for (auto i = std::size_t{0}; i < options.samples; ++i) {
+				auto pick = std::uniform_int_distribution<std::size_t>(i, n - 1);
+				std::swap(sources[i], sources[pick(random)]);
+			}
+			sources.resize(options.samples);
+		}
+		auto const threads = std::min(options.threads == 0 ? detail::default_threads() : options.threads,
+		                              std::max<std::size_t>(1, sources.size()));
+
+		auto ret = betweenness_result{std::vector<double>(n, 0), sources.size(), 0};
+		auto next = std::atomic<std::size_t>{0};
+		// Distance is the type search keeps its distances in
+		auto const run = [&]<typename Distance>(std::type_identity<Distance>, auto&& search) {
+			auto partial = std::vector<std::vector<double>>(threads);
+			detail::parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t t) {
+				auto ws = detail::brandes_workspace<Distance>(n);
+				for (auto i = next.fetch_add(1); i < sources.size(); i = next.fetch_add(1)) {
+					search(ws, sources[i]);
+					ws.reset();
+				}
+				partial[t] = std::move(ws.centrality);
+			});
+			for (auto const& part : partial) {
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					ret.centrality[v] += part[v];
+				}
+			}
+		};
+
+		if (!options.weighted) {
+			struct bfs_search {
+				csr<N, E> const* g;
+				csr<N, E> const* reverse;
+
+				auto operator()(detail::brandes_workspace<std::uint32_t>& ws, node_id s) const -> void {
+					auto& distance = ws.distance;
+					auto& sigma = ws.sigma;
+					distance[s] = 0;
+					sigma[s] = 1;
+					ws.order.push_back(s);
+					// order doubles as the BFS queue
+					for (auto i = std::size_t{0}; i < ws.order.size(); ++i) {
+						auto const u = ws.order[i];
+						auto last = no_node;
+						for (auto const v : g->neighbours(u)) {
+							if (v == last) {
+								continue;
+							}
+							last = v;
+							if (distance[v] == detail::infinity<std::uint32_t>()) {
+								distance[v] = distance[u] + 1;
+								ws.order.push_back(v);
+							}
+							if (distance[v] == distance[u] + 1) {
+								sigma[v] += sigma[u];
+							}
+						}
+					}
+					ws.accumulate(*reverse, s, [&](node_id u, node_id v, E const&, std::size_t k) {
+						// Skip repeats of a parallel edge, as in the forward pass
+						auto const first = k == 0 || reverse->neighbours(v)[k - 1] != u;
+						return first && distance[u] != detail::infinity<std::uint32_t>()
+						       && distance[u] + 1 == distance[v];
+					});
+				}
+			};
+			run(std::type_identity<std::uint32_t>{}, bfs_search{&g, &reverse});
+		}
+		else if constexpr (std::is_arithmetic_v<E>) {
+			for (auto const& w : g.weights()) {
+				if (w < E{}) {
+					auto error_msg = "Cannot call gdwg::betweenness with weighted edges on negative edge weights";
+					throw std::runtime_error(error_msg);
+				}
+			}
+			struct dijkstra_search {
+				csr<N, E> const* g;
+				csr<N, E> const* reverse;
+
+				auto operator()(detail::brandes_workspace<E>& ws, node_id s) const -> void {
+					auto& distance = ws.distance;
+					auto& sigma = ws.sigma;
+					distance[s] = E{};
+					sigma[s] = 1;
+					ws.heap.push_or_decrease(s, E{});
+					while (!ws.heap.empty()) {
+						auto const [u, d] = ws.heap.pop();
+						ws.order.push_back(u);
+						auto const targets = g->neighbours(u);
+						auto const weights = g->weights(u);
+						for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+							auto const v = targets[k];
+							auto const candidate = d + weights[k];
+							if (candidate < distance[v]) {
+								distance[v] = candidate;
+								sigma[v] = sigma[u];
+								ws.heap.push_or_decrease(v, candidate);
+							}
+							else if (candidate == distance[v] && v != u) {
+								sigma[v] += sigma[u];
+							}
+						}
+					}
+					ws.accumulate(*reverse, s, [&](node_id u, node_id v, E const& w, std::size_t) {
+						return u != v && distance[u] != detail::infinity<E>() && distance[u] + w == distance[v];
+					});
+				}
+			};
+			run(std::type_identity<E>{}, dijkstra_search{&g, &reverse});
+		}
+		else {
+			auto error_msg = "Cannot call gdwg::betweenness with weighted edges on weights that are not arithmetic";
+			throw std::runtime_error(error_msg);
+		}
+
+		if (sampled) {
+			auto const k = static_cast<double>(sources.size());
+			auto const scale = static_cast<double>(n) / k;
+			for (auto& c : ret.centrality) {
+				c *= scale;
+			}
+			// Each sample's dependency on a node lies in [0, n - 2]
+			auto const range = static_cast<double>(n) * static_cast<double>(n - 2);
+			auto const failure = 1 - options.confidence;
+			ret.error_bound = range * std::sqrt(std::log(2 * static_cast<double>(n) / failure) / (2 * k));
+		}
+		return ret;
+	}
+
+	/*
+	Betweenness centrality over g, indexed by node id, i.e. by
+	position in g.nodes().
+	*/
+	template<typename N, typename E>
+	auto betweenness(graph<N, E> const& g, betweenness_options const& options = {}) -> betweenness_result {
+		auto const snapshot = csr(g);
+		return betweenness(snapshot, snapshot.transpose(), options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_BETWEENNESS_HPP
@@ -0,0 +1,203 @@
+#ifndef GDWG_BFS_HPP
+#define GDWG_BFS_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Frontier as one bit per node, shared by the bottom-up steps
+		class bitmap {
+		public:
+			explicit bitmap(std::size_t n)
+			: words_((n + 63) / 64, 0) {}
+
+			[[nodiscard]] auto test(std::size_t i) const -> bool {
+				return (words_[i / 64] >> (i % 64) & 1U) != 0;
+			}
+
+			// Safe to call from several threads at once
+			auto set_atomic(std::size_t i) -> void {
+				std::atomic_ref<std::uint64_t>(words_[i / 64]).fetch_or(std::uint64_t{1} << (i % 64),
+				                                                        std::memory_order_relaxed);
+			}
+
+			auto set(std::size_t i) -> void {
+				words_[i / 64] |= std::uint64_t{1} << (i % 64);
+			}
+
+			auto clear() -> void {
+				std::fill(words_.begin(), words_.end(), 0);
+			}
+
+			auto swap(bitmap& other) noexcept -> void {
+				words_.swap(other.words_);
+			}
+
+		private:
+			std::vector<std::uint64_t> words_;
+		};
+
+		// Below this much work per step, threads cost more than they save
+		inline constexpr std::size_t bfs_grain = 4096;
+	} // namespace detail
+
+	/*
+	Breadth-first search from src returning hop distances and parents
+	(distance is detail::infinity<std::uint32_t>() for unreached nodes).
+	Direction-optimizing: small frontiers are expanded top-down over g,
+	and once the frontier's edges outweigh the unexplored edges (by
+	alpha) unvisited nodes instead look for a parent in the frontier
+	bitmap over reverse (g.transpose()), switching back once the
+	frontier shrinks below n / beta nodes. Each step is split across
+	threads threads; 0 uses every core.
+	Throw runtime error if alpha or beta is 0
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	auto bfs(csr<N, E> const& g,
+	         csr<N, E> const& reverse,
+	         node_id src,
+	         std::size_t threads = 0,
+	         std::size_t alpha = 14,
+	         std::size_t beta = 24) -> shortest_paths<std::uint32_t> {
+		if (alpha == 0 || beta == 0) {
+			auto error_msg = "Cannot call gdwg::bfs with an alpha or beta of 0";
+			throw std::runtime_error(error_msg);
+		}
+		auto const n = g.size();
+		auto ret = shortest_paths<std::uint32_t>{
+		   std::vector<std::uint32_t>(n, detail::infinity<std::uint32_t>()),
+		   std::vector<node_id>(n, no_node)};
+		ret.distance[src] = 0;
+		ret.predecessor[src] = src;
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+
+		auto frontier = std::vector<node_id>{src};
+		auto local_frontiers = std::vector<std::vector<node_id>>(threads);
+		auto local_edges = std::vector<std::size_t>(threads);
+		auto local_awake = std::vector<std::size_t>(threads);
+		auto current = detail::bitmap(n);
+		auto next = detail::bitmap(n);
+		auto unexplored_edges = g.num_edges() - g.degree(src);
+		auto bottom_up = false;
+		auto awake = std::size_t{1};
+		auto const& parent = ret.predecessor;
+
+		for (auto level = std::uint32_t{1}; awake != 0; ++level) {
+			std::fill(local_edges.begin(), local_edges.end(), 0);
+			std::fill(local_awake.begin(), local_awake.end(), 0);
+			// A step may use fewer threads than the last, so clear every list
+			for (auto& out : local_frontiers) {
+				out.clear();
+			}
+
+			if (!bottom_up) {
+				auto frontier_edges = std::size_t{0};
+				for (auto const u : frontier) {
+					frontier_edges += g.degree(u);
+				}
+				if (frontier_edges > unexplored_edges / alpha) {
+					bottom_up = true;
+					current.clear();
+					for (auto const u : frontier) {
+						current.set(u);
+					}
+				}
+			}
+
+			if (bottom_up) {
+				next.clear();
+				auto const step_threads = n < detail::bfs_grain ? 1 : threads;
+				detail::parallel_for(n, step_threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+					for (auto v = begin; v < end; ++v) {
+						if (parent[v] != no_node) {
+							continue;
+						}
+						for (auto const u : reverse.neighbours(static_cast<node_id>(v))) {
+							if (current.test(u)) {
+								ret.predecessor[v] = u;
+								ret.distance[v] = level;
+								next.set_atomic(v);
+								++local_awake[t];
+								local_edges[t] += g.degree(static_cast<node_id>(v));
+								break;
+							}
+						}
+					}
+				});
+				current.swap(next);
+			}
+			else {
+				auto const step_threads = frontier.size() < detail::bfs_grain ? 1 : threads;
+				detail::parallel_for(frontier.size(), step_threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+					auto& out = local_frontiers[t];
+					for (auto i = begin; i < end; ++i) {
+						auto const u = frontier[i];
+						for (auto const v : g.neighbours(u)) {
+							auto claim = std::atomic_ref<node_id>(ret.predecessor[v]);
+							auto expected = no_node;
+							if (claim.load(std::memory_order_relaxed) == no_node
+							    && claim.compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+								ret.distance[v] = level;
+								out.push_back(v);
+								local_edges[t] += g.degree(v);
+							}
+						}
+					}
+					local_awake[t] = out.size();
+				});
+				frontier.clear();
+				for (auto const& out : local_frontiers) {
+					frontier.insert(frontier.end(), out.begin(), out.end());
+				}
+			}
+
+			awake = 0;
+			for (auto t = std::size_t{0}; t < threads; ++t) {
+				awake += local_awake[t];
+				unexplored_edges -= local_edges[t];
+			}
+
+			// A small frontier is cheaper to expand top-down again
+			if (bottom_up && awake != 0 && awake < n / beta) {
+				bottom_up = false;
+				frontier.clear();
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					if (current.test(v)) {
+						frontier.push_back(static_cast<node_id>(v));
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	/*
+	Breadth-first search from src over g.
+	Results are indexed by node id, i.e. by position in g.nodes().
+	Throw runtime error if is_node(src) is false
+	*/
+	template<typename N, typename E>
+	auto bfs(graph<N, E> const& g, N const& src, std::size_t threads = 0) -> shortest_paths<std::uint32_t> {
+		if (!g.is_node(src)) {
+			auto error_msg = "Cannot call gdwg::bfs if src doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return bfs(snapshot, snapshot.transpose(), snapshot.id(src), threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_BFS_HPP
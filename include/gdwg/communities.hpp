@@ -0,0 +1,464 @@
+#ifndef GDWG_COMMUNITIES_HPP
+#define GDWG_COMMUNITIES_HPP
+
+#include "gdwg/components.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Community detection on the undirected graph underlying a csr, in
+which the weight between u and v is the total weight of the edges
+u->v and v->u. Quality is measured by modularity: the fraction of
+weight inside communities minus the fraction expected if edges were
+placed at random with the same node strengths. Edge weights must
+convert to double, even when options.weighted is off.
+*/
+namespace gdwg {
+	struct community_options {
+		// Use edge weights, or count every edge as 1
+		bool weighted = true;
+		// Above 1 favours more, smaller communities
+		double resolution = 1.0;
+		// Label propagation rounds, or local moving passes per Louvain level
+		std::size_t max_iterations = 100;
+		// Seeds the order in which nodes are visited
+		std::uint64_t seed = 1;
+		// 0 means one per hardware thread; only label propagation uses threads
+		std::size_t threads = 0;
+	};
+
+	/*
+	A community id (0 .. count - 1) per node id, numbered in order of
+	each community's smallest node, with the modularity achieved and
+	the label propagation rounds or Louvain levels run.
+	*/
+	struct communities {
+		std::vector<node_id> community;
+		std::size_t count = 0;
+		double modularity = 0;
+		std::size_t iterations = 0;
+	};
+
+	namespace detail {
+		/*
+		Symmetric weighted adjacency with parallel edges summed. The
+		weight a node has to itself, loop(u), counts each self-loop
+		twice, as both of its ends are at u; it is kept out of the
+		neighbour lists. strength(u) is the total weight at u.
+		*/
+		class weighted_adjacency {
+		public:
+			weighted_adjacency() = default;
+
+			// reverse must be g.transpose()
+			template<typename N, typename E>
+			   requires std::is_convertible_v<E const&, double>
+			weighted_adjacency(csr<N, E> const& g, csr<N, E> const& reverse, bool weighted)
+			: offsets_(g.size() + 1, 0)
+			, loop_(g.size(), 0)
+			, strength_(g.size(), 0) {
+				if (weighted) {
+					for (auto const& w : g.weights()) {
+						if (w < E{}) {
+							auto error_msg = "Cannot call gdwg::louvain or gdwg::label_propagation with weighted "
+							                 "edges on negative edge weights";
+							throw std::runtime_error(error_msg);
+						}
+					}
+				}
+				auto const weight_of = [weighted](E const& w) { return weighted ? static_cast<double>(w) : 1.0; };
+				targets_.reserve(2 * g.num_edges());
+				weights_.reserve(2 * g.num_edges());
+				for (auto u = node_id{0}; u < g.size(); ++u) {
+					// Both lists are sorted by id, so merge them summing repeats
+					auto const out = g.neighbours(u);
+					auto const out_weights = g.weights(u);
+					auto const in = reverse.neighbours(u);
+					auto const in_weights = reverse.weights(u);
+					auto i = std::size_t{0};
+					auto j = std::size_t{0};
+					while (i < out.size() || j < in.size()) {
+						auto const from_out = j == in.size() || (i < out.size() && out[i] < in[j]);
+						auto const v = from_out ? out[i] : in[j];
+						auto const w = from_out ? weight_of(out_weights[i++]) : weight_of(in_weights[j++]);
+						add(u, v, w);
+					}
+					offsets_[u + 1] = targets_.size();
+				}
+			}
+
+			/*
+			The graph of communities: community c becomes node c, and
+			the weights between and within communities are summed.
+			*/
+			[[nodiscard]] auto aggregate(std::vector<node_id> const& community, std::size_t count) const
+			   -> weighted_adjacency {
+				auto members = std::vector<std::vector<node_id>>(count);
+				for (auto u = node_id{0}; u < size(); ++u) {
+					members[community[u]].push_back(u);
+				}
+				auto ret = weighted_adjacency{};
+				ret.offsets_.assign(count + 1, 0);
+				ret.loop_.assign(count, 0);
+				ret.strength_.assign(count, 0);
+				auto sum = std::vector<double>(count, 0);
+				auto touched = std::vector<node_id>{};
+				for (auto c = node_id{0}; c < count; ++c) {
+					for (auto const u : members[c]) {
+						ret.loop_[c] += loop_[u];
+						ret.strength_[c] += loop_[u];
+						auto const targets = neighbours(u);
+						auto const weights = this->weights(u);
+						for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+							auto const d = community[targets[k]];
+							if (sum[d] == 0) {
+								touched.push_back(d);
+							}
+							sum[d] += weights[k];
+						}
+					}
+					std::sort(touched.begin(), touched.end());
+					for (auto const d : touched) {
+						ret.add(c, d, sum[d]);
+						sum[d] = 0;
+					}
+					touched.clear();
+					ret.offsets_[c + 1] = ret.targets_.size();
+				}
+				return ret;
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return loop_.size();
+			}
+
+			[[nodiscard]] auto neighbours(node_id u) const -> std::span<node_id const> {
+				return {targets_.data() + offsets_[u], offsets_[u + 1] - offsets_[u]};
+			}
+
+			[[nodiscard]] auto weights(node_id u) const -> std::span<double const> {
+				return {weights_.data() + offsets_[u], offsets_[u + 1] - offsets_[u]};
+			}
+
+			[[nodiscard]] auto loop(node_id u) const -> double {
+				return loop_[u];
+			}
+
+			[[nodiscard]] auto strength(node_id u) const -> double {
+				return strength_[u];
+			}
+
+			// Twice the total edge weight, i.e. the sum of all strengths
+			[[nodiscard]] auto total() const -> double {
+				return std::accumulate(strength_.begin(), strength_.end(), 0.0);
+			}
+
+			/*
+			Modularity of a partition into count communities.
+			Time Complexity : O(n+e)
+			*/
+			[[nodiscard]] auto modularity(std::vector<node_id> const& community, std::size_t count, double resolution) const
+			   -> double {
+				auto const two_m = total();
+				if (two_m == 0) {
+					return 0;
+				}
+				auto inside = std::vector<double>(count, 0);
+				auto tot = std::vector<double>(count, 0);
+				for (auto u = node_id{0}; u < size(); ++u) {
+					auto const c = community[u];
+					tot[c] += strength_[u];
+					inside[c] += loop_[u];
+					auto const targets = neighbours(u);
+					auto const weights = this->weights(u);
+					for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+						if (community[targets[k]] == c) {
+							inside[c] += weights[k];
+						}
+					}
+				}
+				auto ret = 0.0;
+				for (auto c = std::size_t{0}; c < count; ++c) {
+					ret += inside[c] / two_m - resolution * (tot[c] / two_m) * (tot[c] / two_m);
+				}
+				return ret;
+			}
+
+		private:
+			std::vector<std::size_t> offsets_;
+			std::vector<node_id> targets_;
+			std::vector<double> weights_;
+			std::vector<double> loop_;
+			std::vector<double> strength_;
+
+			// Add weight w to u's entry for v; entries arrive sorted by v
+			auto add(node_id u, node_id v, double w) -> void {
+				strength_[u] += w;
+				if (u == v) {
+					loop_[u] += w;
+				}
+				else if (targets_.size() > offsets_[u] && targets_.back() == v) {
+					weights_.back() += w;
+				}
+				else {
+					targets_.push_back(v);
+					weights_.push_back(w);
+				}
+			}
+		};
+
+		// Nodes in a random order fixed by seed
+		inline auto visiting_order(std::size_t n, std::uint64_t seed) -> std::vector<node_id> {
+			auto ret = std::vector<node_id>(n);
+			std::iota(ret.begin(), ret.end(), node_id{0});
+			std::shuffle(ret.begin(), ret.end(), std::mt19937_64(seed));
+			return ret;
+		}
+	} // namespace detail
+
+	/*
+	Modularity of a partition of g given as a community id per node,
+	with the weights and resolution of options.
+	reverse must be g.transpose().
+	Throw runtime error if options.weighted is set and an edge has a
+	negative weight
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	   requires std::is_convertible_v<E const&, double>
+	auto modularity(csr<N, E> const& g,
+	                csr<N, E> const& reverse,
+	                std::vector<node_id> const& community,
+	                community_options const& options = {}) -> double {
+		auto const count = community.empty() ? 0 : *std::max_element(community.begin(), community.end()) + 1;
+		return detail::weighted_adjacency(g, reverse, options.weighted)
+		   .modularity(community, count, options.resolution);
+	}
+
+	/*
+	Communities by label propagation: every node starts in its own
+	community and repeatedly joins the one it has the most weight to,
+	staying put on a tie with its own. Nodes are visited in a seeded
+	random order split between the threads, and labels are updated in
+	place, so later nodes in a round already see the new labels; this
+	avoids the oscillation of fully synchronous rounds. Stops after a
+	round that changes nothing, or options.max_iterations rounds.
+	With more than one thread the result may vary between runs.
+	reverse must be g.transpose().
+	Throw runtime error if options.weighted is set and an edge has a
+	negative weight
+	Time Complexity : O(n+e*log(d)) per round, d being the largest degree
+	*/
+	template<typename N, typename E>
+	   requires std::is_convertible_v<E const&, double>
+	auto label_propagation(csr<N, E> const& g, csr<N, E> const& reverse, community_options const& options = {})
+	   -> communities {
+		auto const adjacency = detail::weighted_adjacency(g, reverse, options.weighted);
+		auto const n = adjacency.size();
+		auto const order = detail::visiting_order(n, options.seed);
+		auto label = std::vector<std::atomic<node_id>>(n);
+		for (auto u = node_id{0}; u < n; ++u) {
+			label[u].store(u, std::memory_order_relaxed);
+		}
+		auto const threads = std::max<std::size_t>(
+		   1,
+		   std::min(options.threads == 0 ? detail::default_threads() : options.threads, n));
+		auto changes = std::vector<std::size_t>(threads);
+
+		auto ret = communities{};
+		while (ret.iterations < options.max_iterations) {
+			++ret.iterations;
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+				// Weight to each neighbouring label, summed by sorting so
+				// memory follows the degree rather than the node count
+				auto votes = std::vector<std::pair<node_id, double>>{};
+				changes[t] = 0;
+				for (auto i = begin; i < end; ++i) {
+					auto const u = order[i];
+					auto const targets = adjacency.neighbours(u);
+					auto const weights = adjacency.weights(u);
+					votes.clear();
+					for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+						votes.emplace_back(label[targets[k]].load(std::memory_order_relaxed), weights[k]);
+					}
+					std::sort(votes.begin(), votes.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+					auto labels = std::size_t{0};
+					for (auto k = std::size_t{0}; k < votes.size(); ++k) {
+						if (labels > 0 && votes[labels - 1].first == votes[k].first) {
+							votes[labels - 1].second += votes[k].second;
+						}
+						else {
+							votes[labels++] = votes[k];
+						}
+					}
+					votes.resize(labels);
+					auto const current = label[u].load(std::memory_order_relaxed);
+					auto best = current;
+					auto best_weight = 0.0;
+					for (auto const& [l, w] : votes) {
+						if (l == current) {
+							best_weight = w;
+						}
+					}
+					// Labels are ascending, so a tie goes to the smallest
+					for (auto const& [l, w] : votes) {
+						if (w > best_weight) {
+							best = l;
+							best_weight = w;
+						}
+					}
+					if (best != current) {
+						label[u].store(best, std::memory_order_relaxed);
+						++changes[t];
+					}
+				}
+			});
+			if (std::accumulate(changes.begin(), changes.end(), std::size_t{0}) == 0) {
+				break;
+			}
+		}
+
+		auto representative = std::vector<node_id>(n);
+		for (auto u = node_id{0}; u < n; ++u) {
+			representative[u] = label[u].load(std::memory_order_relaxed);
+		}
+		auto const partition = detail::dense_components(representative);
+		ret.community = partition.component;
+		ret.count = partition.count;
+		ret.modularity = adjacency.modularity(ret.community, ret.count, options.resolution);
+		return ret;
+	}
+
+	/*
+	Communities by the Louvain method. Each level moves nodes one at a
+	time, in a seeded random order, to the neighbouring community with
+	the largest modularity gain until a pass improves nothing, then
+	merges every community into a single node and repeats on the
+	smaller graph. Stops at the first level that moves no node.
+	All levels work on flat weighted adjacency arrays; the graph of
+	communities shrinks quickly, so the first level dominates.
+	reverse must be g.transpose().
+	Throw runtime error if options.weighted is set and an edge has a
+	negative weight
+	Time Complexity : O(n+e) per pass
+	*/
+	template<typename N, typename E>
+	   requires std::is_convertible_v<E const&, double>
+	auto louvain(csr<N, E> const& g, csr<N, E> const& reverse, community_options const& options = {}) -> communities {
+		auto const original = detail::weighted_adjacency(g, reverse, options.weighted);
+		auto const n = original.size();
+		auto const two_m = original.total();
+		auto ret = communities{};
+		// Community of every original node, refined level by level
+		auto representative = std::vector<node_id>(n);
+		std::iota(representative.begin(), representative.end(), node_id{0});
+
+		auto level = original;
+		while (two_m > 0) {
+			auto const size = level.size();
+			auto community = std::vector<node_id>(size);
+			std::iota(community.begin(), community.end(), node_id{0});
+			auto tot = std::vector<double>(size);
+			for (auto u = node_id{0}; u < size; ++u) {
+				tot[u] = level.strength(u);
+			}
+			auto weight_to = std::vector<double>(size, 0);
+			auto touched = std::vector<node_id>{};
+			auto const order = detail::visiting_order(size, options.seed + ret.iterations);
+
+			auto moved_any = false;
+			for (auto pass = std::size_t{0}; pass < options.max_iterations; ++pass) {
+				auto moved = false;
+				for (auto const u : order) {
+					auto const current = community[u];
+					auto const k = level.strength(u);
+					auto const targets = level.neighbours(u);
+					auto const weights = level.weights(u);
+					for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+						auto const c = community[targets[i]];
+						if (weight_to[c] == 0) {
+							touched.push_back(c);
+						}
+						weight_to[c] += weights[i];
+					}
+					tot[current] -= k;
+					// Gain of joining c, up to terms that do not depend on c
+					auto const gain = [&](node_id c) {
+						return weight_to[c] - options.resolution * tot[c] * k / two_m;
+					};
+					auto best = current;
+					auto best_gain = gain(current);
+					for (auto const c : touched) {
+						if (gain(c) > best_gain) {
+							best = c;
+							best_gain = gain(c);
+						}
+					}
+					for (auto const c : touched) {
+						weight_to[c] = 0;
+					}
+					touched.clear();
+					tot[best] += k;
+					if (best != current) {
+						community[u] = best;
+						moved = true;
+					}
+				}
+				if (!moved) {
+					break;
+				}
+				moved_any = true;
+			}
+			if (!moved_any) {
+				break;
+			}
+
+			++ret.iterations;
+			auto const partition = detail::dense_components(community);
+			for (auto& r : representative) {
+				r = partition.component[r];
+			}
+			level = level.aggregate(partition.component, partition.count);
+		}
+
+		// Renumber by smallest member, as label_propagation does
+		auto const partition = detail::dense_components(representative);
+		ret.community = partition.component;
+		ret.count = partition.count;
+		ret.modularity = original.modularity(ret.community, ret.count, options.resolution);
+		return ret;
+	}
+
+	/*
+	Convenience overloads over a graph.
+	Results are indexed by node id, i.e. by position in g.nodes().
+	*/
+	template<typename N, typename E>
+	   requires std::is_convertible_v<E const&, double>
+	auto label_propagation(graph<N, E> const& g, community_options const& options = {}) -> communities {
+		auto const snapshot = csr(g);
+		return label_propagation(snapshot, snapshot.transpose(), options);
+	}
+
+	template<typename N, typename E>
+	   requires std::is_convertible_v<E const&, double>
+	auto louvain(graph<N, E> const& g, community_options const& options = {}) -> communities {
+		auto const snapshot = csr(g);
+		return louvain(snapshot, snapshot.transpose(), options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_COMMUNITIES_HPP
@@ -0,0 +1,49 @@
+#ifndef GDWG_COMPONENTS_HPP
+#define GDWG_COMPONENTS_HPP
+
+#include "gdwg/csr.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace gdwg {
+	/*
+	A partition of the nodes into count components, with the
+	component id (0 .. count - 1) of every node indexed by node id.
+	*/
+	struct components {
+		std::vector<node_id> component;
+		std::size_t count = 0;
+
+		// Nodes of every component, each in ascending order
+		[[nodiscard]] auto members() const -> std::vector<std::vector<node_id>> {
+			auto ret = std::vector<std::vector<node_id>>(count);
+			for (auto v = node_id{0}; v < component.size(); ++v) {
+				ret[component[v]].push_back(v);
+			}
+			return ret;
+		}
+	};
+
+	namespace detail {
+		/*
+		Components from a representative per node, numbered densely in
+		order of each component's smallest node.
+		*/
+		inline auto dense_components(std::vector<node_id> const& representative) -> components {
+			auto const n = representative.size();
+			auto ret = components{std::vector<node_id>(n), 0};
+			auto id = std::vector<node_id>(n, no_node);
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				auto& c = id[representative[v]];
+				if (c == no_node) {
+					c = static_cast<node_id>(ret.count++);
+				}
+				ret.component[v] = c;
+			}
+			return ret;
+		}
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_COMPONENTS_HPP
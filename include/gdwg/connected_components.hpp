@@ -0,0 +1,166 @@
+#ifndef GDWG_CONNECTED_COMPONENTS_HPP
+#define GDWG_CONNECTED_COMPONENTS_HPP
+
+#include "gdwg/components.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		/*
+		Lock-free union-find over node ids for concurrent unions.
+		A parent never has a larger id than its child, so roots only
+		change by a compare-and-swap that points a root at a smaller one.
+		*/
+		class concurrent_union_find {
+		public:
+			explicit concurrent_union_find(std::size_t n)
+			: parent_(n) {
+				for (auto v = node_id{0}; v < n; ++v) {
+					parent_[v] = v;
+				}
+			}
+
+			[[nodiscard]] auto parent(node_id v) const -> node_id {
+				return std::atomic_ref<node_id const>(parent_[v]).load(std::memory_order_relaxed);
+			}
+
+			// Safe to call from several threads at once
+			auto unite(node_id u, node_id v) -> void {
+				auto a = parent(u);
+				auto b = parent(v);
+				while (a != b) {
+					auto const high = std::max(a, b);
+					auto const low = std::min(a, b);
+					auto expected = parent(high);
+					if (expected == low) {
+						return;
+					}
+					if (expected == high
+					    && std::atomic_ref<node_id>(parent_[high]).compare_exchange_strong(expected,
+					                                                                       low,
+					                                                                       std::memory_order_relaxed)) {
+						return;
+					}
+					// high was linked elsewhere meanwhile; climb and retry
+					a = parent(parent(high));
+					b = parent(low);
+				}
+			}
+
+			/*
+			Point every node in [begin, end) straight at its root.
+			Safe to call on disjoint ranges at once, as long as no
+			unite() runs at the same time.
+			*/
+			auto compress(std::size_t begin, std::size_t end) -> void {
+				for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+					while (parent(v) != parent(parent(v))) {
+						std::atomic_ref<node_id>(parent_[v]).store(parent(parent(v)), std::memory_order_relaxed);
+					}
+				}
+			}
+
+			[[nodiscard]] auto parents() const noexcept -> std::vector<node_id> const& {
+				return parent_;
+			}
+
+		private:
+			std::vector<node_id> parent_;
+		};
+
+		// Edges per node linked before sampling, as in Afforest
+		inline constexpr std::size_t afforest_rounds = 2;
+		inline constexpr std::size_t afforest_samples = 1024;
+	} // namespace detail
+
+	/*
+	Weakly connected components, i.e. components when edge direction
+	is ignored. reverse must be g.transpose().
+	Follows Afforest: every node is first united with only its first
+	few neighbours, in parallel chunks of nodes. A random sample then
+	finds the component most nodes already belong to, which in most
+	graphs is one giant component, and only nodes outside it have
+	their remaining edges (both directions) united. Unions use a
+	lock-free union-find, and paths are compressed between phases.
+	Components are numbered in order of their smallest node.
+	Time Complexity : O(n+e) expected in practice
+	*/
+	template<typename N, typename E>
+	auto weakly_connected_components(csr<N, E> const& g, csr<N, E> const& reverse, std::size_t threads = 0)
+	   -> components {
+		auto const n = g.size();
+		auto sets = detail::concurrent_union_find(n);
+		auto const compress = [&sets, n, threads] {
+			detail::parallel_for(n, threads, [&sets](std::size_t begin, std::size_t end, std::size_t) {
+				sets.compress(begin, end);
+			});
+		};
+
+		for (auto round = std::size_t{0}; round < detail::afforest_rounds; ++round) {
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto u = static_cast<node_id>(begin); u < end; ++u) {
+					auto const neighbours = g.neighbours(u);
+					if (round < neighbours.size()) {
+						sets.unite(u, neighbours[round]);
+					}
+				}
+			});
+			compress();
+		}
+
+		// Most frequent root among the samples; its nodes need no more work
+		auto skip = no_node;
+		if (n > 0) {
+			auto random = std::minstd_rand(n);
+			auto pick = std::uniform_int_distribution<node_id>(0, static_cast<node_id>(n - 1));
+			auto counts = std::unordered_map<node_id, std::size_t>{};
+			auto best = std::size_t{0};
+			for (auto i = std::size_t{0}; i < detail::afforest_samples; ++i) {
+				auto const root = sets.parent(pick(random));
+				if (++counts[root] > best) {
+					best = counts[root];
+					skip = root;
+				}
+			}
+		}
+
+		detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (auto u = static_cast<node_id>(begin); u < end; ++u) {
+				if (sets.parent(u) == skip) {
+					continue;
+				}
+				auto const neighbours = g.neighbours(u);
+				for (auto k = std::min(detail::afforest_rounds, neighbours.size()); k < neighbours.size(); ++k) {
+					sets.unite(u, neighbours[k]);
+				}
+				// An edge from the skipped component into u is only seen from u's side
+				for (auto const v : reverse.neighbours(u)) {
+					sets.unite(u, v);
+				}
+			}
+		});
+		compress();
+		return detail::dense_components(sets.parents());
+	}
+
+	/*
+	Weakly connected components of g.
+	Components are indexed by node id, i.e. by position in g.nodes().
+	*/
+	template<typename N, typename E>
+	auto weakly_connected_components(graph<N, E> const& g, std::size_t threads = 0) -> components {
+		auto const snapshot = csr(g);
+		return weakly_connected_components(snapshot, snapshot.transpose(), threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_CONNECTED_COMPONENTS_HPP
@@ -0,0 +1,554 @@
+#ifndef GDWG_CONTRACTION_HIERARCHY_HPP
+#define GDWG_CONTRACTION_HIERARCHY_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Contraction hierarchies for repeated point-to-point distance queries
+on a graph that rarely changes. Preprocessing contracts the nodes one
+at a time, least important first, adding a shortcut u->w around each
+contracted node v whenever u->v->w may be the only shortest path.
+Every shortest path then has an equally short version that only
+climbs in importance from src and descends to dst, so a query is a
+bidirectional Dijkstra over the upward edges alone that settles a few
+hundred nodes on road networks instead of a large part of the graph.
+*/
+namespace gdwg {
+	namespace detail {
+		// Nodes a witness search may settle before assuming there is no witness
+		inline constexpr auto witness_settle_limit = std::size_t{128};
+
+		/*
+		The graph while it is being contracted. Parallel edges are merged
+		into the lightest and self-loops dropped. A contracted node is
+		removed from its neighbours' lists but keeps its own, which then
+		only hold the nodes contracted after it, i.e. its upward edges.
+		*/
+		template<typename E>
+		class contraction_state {
+		public:
+			using arc = std::pair<node_id, E>;
+
+			template<typename N>
+			explicit contraction_state(csr<N, E> const& g)
+			: out_(g.size())
+			, in_(g.size())
+			, contracted_neighbours_(g.size(), 0)
+			, level_(g.size(), 0)
+			, target_(g.size(), false)
+			, distance_(g.size(), infinity<E>())
+			, heap_(g.size()) {
+				for (auto u = node_id{0}; u < g.size(); ++u) {
+					auto const targets = g.neighbours(u);
+					auto const weights = g.weights(u);
+					for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+						if (targets[k] != u) {
+							add_edge(u, targets[k], weights[k]);
+						}
+					}
+				}
+			}
+
+			[[nodiscard]] auto out(node_id u) const -> std::vector<arc> const& {
+				return out_[u];
+			}
+
+			[[nodiscard]] auto in(node_id u) const -> std::vector<arc> const& {
+				return in_[u];
+			}
+
+			/*
+			Contract v, or with dry_run only count the shortcuts that
+			contracting it would add. Return that count.
+			*/
+			auto contract(node_id v, bool dry_run) -> std::size_t {
+				auto shortcuts = std::size_t{0};
+				auto const& incoming = in_[v];
+				auto const& outgoing = out_[v];
+				for (auto const& [u, to_v] : incoming) {
+					auto limit = E{};
+					auto targets = std::size_t{0};
+					for (auto const& [w, from_v] : outgoing) {
+						if (w != u) {
+							limit = std::max(limit, to_v + from_v);
+							target_[w] = true;
+							++targets;
+						}
+					}
+					witness_search(u, v, limit, targets);
+					for (auto const& [w, from_v] : outgoing) {
+						target_[w] = false;
+					}
+					for (auto const& [w, from_v] : outgoing) {
+						if (w == u || distance_[w] <= to_v + from_v) {
+							continue;
+						}
+						++shortcuts;
+						if (!dry_run) {
+							add_edge(u, w, to_v + from_v);
+						}
+					}
+				}
+				if (!dry_run) {
+					auto const is_v = [v](arc const& a) { return a.first == v; };
+					for (auto const& [u, weight] : incoming) {
+						std::erase_if(out_[u], is_v);
+						++contracted_neighbours_[u];
+						level_[u] = std::max(level_[u], level_[v] + 1);
+					}
+					for (auto const& [w, weight] : outgoing) {
+						std::erase_if(in_[w], is_v);
+						++contracted_neighbours_[w];
+						level_[w] = std::max(level_[w], level_[v] + 1);
+					}
+				}
+				return shortcuts;
+			}
+
+			/*
+			Priority of v for contraction, lower first: the edge
+			difference keeps the graph sparse, counting contracted
+			neighbours spreads the contraction evenly over the graph, and
+			the level (how many contractions lie below v) keeps the
+			hierarchy shallow, which shortens the queries.
+			*/
+			[[nodiscard]] auto priority(node_id v) -> long {
+				auto const shortcuts = static_cast<long>(contract(v, true));
+				auto const removed = static_cast<long>(in_[v].size() + out_[v].size());
+				return 2 * (shortcuts - removed) + static_cast<long>(contracted_neighbours_[v] + level_[v]);
+			}
+
+		private:
+			std::vector<std::vector<arc>> out_;
+			std::vector<std::vector<arc>> in_;
+			std::vector<std::size_t> contracted_neighbours_;
+			std::vector<std::size_t> level_;
+			// Marks the nodes a witness search has yet to settle
+			std::vector<bool> target_;
+			// Witness search state, reset through touched_
+			std::vector<E> distance_;
+			std::vector<node_id> touched_;
+			d_ary_heap<E> heap_;
+
+			// Add u->w, or lower its weight if it is already there
+			auto add_edge(node_id u, node_id w, E const& weight) -> void {
+				auto const same = [w](arc const& a) { return a.first == w; };
+				auto const it = std::find_if(out_[u].begin(), out_[u].end(), same);
+				if (it == out_[u].end()) {
+					out_[u].emplace_back(w, weight);
+					in_[w].emplace_back(u, weight);
+					return;
+				}
+				if (weight < it->second) {
+					it->second = weight;
+					std::find_if(in_[w].begin(), in_[w].end(), [u](arc const& a) { return a.first == u; })->second =
+					   weight;
+				}
+			}
+
+			/*
+			Dijkstra from u over the nodes not yet contracted, avoiding
+			v, until distances pass limit, all targets are settled or
+			witness_settle_limit nodes are. A distance left too long only
+			costs a superfluous shortcut, never a wrong answer.
+			*/
+			auto witness_search(node_id u, node_id v, E const& limit, std::size_t targets) -> void {
+				for (auto const x : touched_) {
+					distance_[x] = infinity<E>();
+				}
+				touched_.clear();
+				heap_.clear();
+				distance_[u] = E{};
+				touched_.push_back(u);
+				heap_.push_or_decrease(u, E{});
+				for (auto settled = std::size_t{0}; !heap_.empty() && settled < witness_settle_limit; ++settled) {
+					auto const [x, d] = heap_.pop();
+					if (limit < d || (target_[x] && --targets == 0)) {
+						break;
+					}
+					for (auto const& [y, weight] : out_[x]) {
+						if (y == v || !(d + weight < distance_[y])) {
+							continue;
+						}
+						if (distance_[y] == infinity<E>()) {
+							touched_.push_back(y);
+						}
+						distance_[y] = d + weight;
+						heap_.push_or_decrease(y, d + weight);
+					}
+				}
+			}
+		};
+	} // namespace detail
+
+	/*
+	Preprocessed form of a graph for distance queries between node ids,
+	i.e. positions in graph::nodes(). It holds only the upward edges of
+	the hierarchy and can be written to and read back from a stream, so
+	the preprocessing is done once per graph rather than per process.
+	*/
+	template<typename E>
+	class contraction_hierarchy {
+	public:
+		/*
+		Per thread query state. Sized on first use and afterwards reset
+		in time proportional to the nodes the last query touched.
+		*/
+		class workspace {
+		public:
+			workspace() = default;
+
+		private:
+			struct half {
+				std::vector<E> distance;
+				std::vector<node_id> touched;
+				detail::d_ary_heap<E> heap;
+
+				auto prepare(std::size_t n) -> void {
+					if (distance.size() != n) {
+						distance.assign(n, detail::infinity<E>());
+						heap.resize(n);
+						touched.clear();
+						return;
+					}
+					for (auto const v : touched) {
+						distance[v] = detail::infinity<E>();
+					}
+					touched.clear();
+					heap.clear();
+				}
+
+				auto relax(node_id v, E const& d) -> void {
+					if (!(d < distance[v])) {
+						return;
+					}
+					if (distance[v] == detail::infinity<E>()) {
+						touched.push_back(v);
+					}
+					distance[v] = d;
+					heap.push_or_decrease(v, d);
+				}
+			};
+
+			half forward_;
+			half backward_;
+
+			friend class contraction_hierarchy;
+		};
+
+		contraction_hierarchy() = default;
+
+		/*
+		Contract every node of g in order of a lazily updated priority:
+		the top node's priority is recomputed when it is popped, and it
+		goes back into the queue if it is no longer the smallest, and the
+		neighbours of each contracted node are recomputed.
+		Throw runtime error if an edge has a negative weight
+		Time Complexity : O(n*d^3*s*log(s)), d being the largest degree
+		during contraction and s the witness_settle_limit
+		*/
+		template<typename N>
+		explicit contraction_hierarchy(csr<N, E> const& g) {
+			for (auto const& w : g.weights()) {
+				if (w < E{}) {
+					auto error_msg = "Cannot call gdwg::contraction_hierarchy<E> on a graph with negative edge weights";
+					throw std::runtime_error(error_msg);
+				}
+			}
+			auto const n = g.size();
+			auto state = detail::contraction_state<E>(g);
+			auto queue = detail::d_ary_heap<long>(n);
+			for (auto v = node_id{0}; v < n; ++v) {
+				queue.push_or_decrease(v, state.priority(v));
+			}
+			while (!queue.empty()) {
+				auto const v = queue.pop().first;
+				auto const priority = state.priority(v);
+				if (!queue.empty() && queue.top().second < priority) {
+					queue.push_or_decrease(v, priority);
+					continue;
+				}
+				// Contraction changes the neighbours' priorities, so refresh them
+				auto neighbours = std::vector<node_id>{};
+				for (auto const& [w, weight] : state.out(v)) {
+					neighbours.push_back(w);
+				}
+				for (auto const& [u, weight] : state.in(v)) {
+					neighbours.push_back(u);
+				}
+				state.contract(v, false);
+				std::sort(neighbours.begin(), neighbours.end());
+				neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+				for (auto const u : neighbours) {
+					queue.update(u, state.priority(u));
+				}
+			}
+
+			// What each node kept is exactly its upward edges in both directions
+			up_offsets_.assign(n + 1, 0);
+			down_offsets_.assign(n + 1, 0);
+			for (auto v = node_id{0}; v < n; ++v) {
+				up_offsets_[v + 1] = up_offsets_[v] + state.out(v).size();
+				down_offsets_[v + 1] = down_offsets_[v] + state.in(v).size();
+				for (auto const& [w, weight] : state.out(v)) {
+					up_targets_.push_back(w);
+					up_weights_.push_back(weight);
+				}
+				for (auto const& [u, weight] : state.in(v)) {
+					down_targets_.push_back(u);
+					down_weights_.push_back(weight);
+				}
+			}
+			shortcuts_ = num_edges() - count_merged_edges(g);
+		}
+
+		/*
+		Preprocess g directly. Node ids are positions in g.nodes().
+		Throw runtime error if an edge has a negative weight
+		*/
+		template<typename N>
+		explicit contraction_hierarchy(graph<N, E> const& g)
+		: contraction_hierarchy(csr(g)) {}
+
+		// Number of nodes
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return up_offsets_.empty() ? 0 : up_offsets_.size() - 1;
+		}
+
+		// Number of edges in the hierarchy, shortcuts included
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return up_targets_.size() + down_targets_.size();
+		}
+
+		// Number of edges added by contraction
+		[[nodiscard]] auto num_shortcuts() const noexcept -> std::size_t {
+			return shortcuts_;
+		}
+
+		/*
+		Distance from src to dst, or detail::infinity<E>() if dst cannot
+		be reached. Nodes that an already settled higher node reaches
+		more cheaply are stalled and not expanded.
+		Time Complexity : O(s*log(s)), s being the number of nodes in
+		the upward search spaces of src and dst
+		*/
+		[[nodiscard]] auto distance(node_id src, node_id dst, workspace& ws) const -> E {
+			auto& fwd = ws.forward_;
+			auto& bwd = ws.backward_;
+			fwd.prepare(size());
+			bwd.prepare(size());
+			fwd.relax(src, E{});
+			bwd.relax(dst, E{});
+			auto best = src == dst ? E{} : detail::infinity<E>();
+
+			// Search upward on one side; the other direction's upward
+			// edges into u are the ones that could stall it
+			auto const expand = [this, &best](half_type& side,
+			                                  half_type const& other,
+			                                  std::vector<std::uint64_t> const& offsets,
+			                                  std::vector<node_id> const& targets,
+			                                  std::vector<E> const& weights,
+			                                  std::vector<std::uint64_t> const& stall_offsets,
+			                                  std::vector<node_id> const& stall_targets,
+			                                  std::vector<E> const& stall_weights) {
+				auto const [u, d] = side.heap.pop();
+				if (other.distance[u] != detail::infinity<E>() && d + other.distance[u] < best) {
+					best = d + other.distance[u];
+				}
+				for (auto k = stall_offsets[u]; k < stall_offsets[u + 1]; ++k) {
+					auto const x = stall_targets[k];
+					if (side.distance[x] != detail::infinity<E>() && side.distance[x] + stall_weights[k] < d) {
+						return;
+					}
+				}
+				for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+					side.relax(targets[k], d + weights[k]);
+				}
+			};
+
+			while (true) {
+				auto const f_top = fwd.heap.empty() ? detail::infinity<E>() : fwd.heap.top().second;
+				auto const b_top = bwd.heap.empty() ? detail::infinity<E>() : bwd.heap.top().second;
+				auto const forward = !(b_top < f_top);
+				if (!((forward ? f_top : b_top) < best)) {
+					break;
+				}
+				if (forward) {
+					expand(fwd, bwd, up_offsets_, up_targets_, up_weights_, down_offsets_, down_targets_, down_weights_);
+				}
+				else {
+					expand(bwd, fwd, down_offsets_, down_targets_, down_weights_, up_offsets_, up_targets_, up_weights_);
+				}
+			}
+			return best;
+		}
+
+		/*
+		Write the hierarchy to os in a compact binary form that load()
+		reads back. The form uses the native byte order and sizeof(E),
+		so it is meant for the same platform and weight type.
+		*/
+		auto save(std::ostream& os) const -> void
+		   requires std::is_trivially_copyable_v<E>
+		{
+			os.write(magic.data(), magic.size());
+			auto const header = std::array<std::uint64_t, 5>{
+			   sizeof(E), size(), up_targets_.size(), down_targets_.size(), shortcuts_};
+			write(os, header);
+			write(os, up_offsets_);
+			write(os, up_targets_);
+			write(os, up_weights_);
+			write(os, down_offsets_);
+			write(os, down_targets_);
+			write(os, down_weights_);
+		}
+
+		/*
+		Read a hierarchy written by save(). Everything read is checked
+		before it is used: the sizes in the header against what is left
+		of a seekable stream, the offsets for being ascending from 0, and
+		every target for being a node, so a damaged file is rejected
+		rather than read out of bounds by distance().
+		Throw runtime error if is does not hold a hierarchy with this
+		weight type, or is truncated or corrupt
+		*/
+		[[nodiscard]] static auto load(std::istream& is) -> contraction_hierarchy
+		   requires std::is_trivially_copyable_v<E>
+		{
+			auto found = std::array<char, 8>{};
+			auto header = std::array<std::uint64_t, 5>{};
+			is.read(found.data(), found.size());
+			read(is, header);
+			if (!is || found != magic || header[0] != sizeof(E)) {
+				auto error_msg = "Cannot call gdwg::contraction_hierarchy<E>::load on a stream that does not hold a "
+				                 "contraction hierarchy of this weight type";
+				throw std::runtime_error(error_msg);
+			}
+			auto const corrupt = [] {
+				auto error_msg = "Cannot call gdwg::contraction_hierarchy<E>::load on a truncated or corrupt stream";
+				throw std::runtime_error(error_msg);
+			};
+			auto const [width, n, up, down, shortcuts] = header;
+			if (n >= no_node) {
+				corrupt();
+			}
+			// Compare the sizes against the bytes left, without overflowing
+			auto const here = is.tellg();
+			if (here != std::istream::pos_type(-1) && is.seekg(0, std::ios::end)) {
+				auto const left = static_cast<std::uint64_t>(is.tellg() - here);
+				is.seekg(here);
+				auto const edge_bytes = sizeof(node_id) + sizeof(E);
+				auto const offset_bytes = 2 * (n + 1) * sizeof(std::uint64_t);
+				if (offset_bytes > left || up > (left - offset_bytes) / edge_bytes
+				    || down > (left - offset_bytes) / edge_bytes - up)
+				{
+					corrupt();
+				}
+			}
+			is.clear();
+
+			auto ret = contraction_hierarchy{};
+			ret.shortcuts_ = shortcuts;
+			read_checked(is, ret.up_offsets_, n + 1);
+			read_checked(is, ret.up_targets_, up);
+			read_checked(is, ret.up_weights_, up);
+			read_checked(is, ret.down_offsets_, n + 1);
+			read_checked(is, ret.down_targets_, down);
+			read_checked(is, ret.down_weights_, down);
+			auto const valid_offsets = [](std::vector<std::uint64_t> const& offsets, std::uint64_t edges) {
+				return offsets.front() == 0 && offsets.back() == edges
+				       && std::is_sorted(offsets.begin(), offsets.end());
+			};
+			auto const valid_targets = [n](std::vector<node_id> const& targets) {
+				return std::all_of(targets.begin(), targets.end(), [n](node_id v) { return v < n; });
+			};
+			if (!is || !valid_offsets(ret.up_offsets_, up) || !valid_offsets(ret.down_offsets_, down)
+			    || !valid_targets(ret.up_targets_) || !valid_targets(ret.down_targets_) || shortcuts > up + down)
+			{
+				corrupt();
+			}
+			return ret;
+		}
+
+		[[nodiscard]] auto operator==(contraction_hierarchy const& other) const -> bool = default;
+
+	private:
+		using half_type = typename workspace::half;
+
+		static constexpr auto magic = std::array<char, 8>{'g', 'd', 'w', 'g', '-', 'c', 'h', '1'};
+
+		// The upward edges out of each node
+		std::vector<std::uint64_t> up_offsets_;
+		std::vector<node_id> up_targets_;
+		std::vector<E> up_weights_;
+		// The edges into each node from a higher one, stored reversed
+		std::vector<std::uint64_t> down_offsets_;
+		std::vector<node_id> down_targets_;
+		std::vector<E> down_weights_;
+		std::size_t shortcuts_ = 0;
+
+		// Edges of g once parallel edges are merged and self-loops dropped
+		template<typename N>
+		static auto count_merged_edges(csr<N, E> const& g) -> std::size_t {
+			auto ret = std::size_t{0};
+			for (auto u = node_id{0}; u < g.size(); ++u) {
+				auto last = no_node;
+				for (auto const v : g.neighbours(u)) {
+					ret += v != u && v != last;
+					last = v;
+				}
+			}
+			return ret;
+		}
+
+		template<typename Container>
+		static auto write(std::ostream& os, Container const& data) -> void {
+			os.write(reinterpret_cast<char const*>(data.data()),
+			         static_cast<std::streamsize>(data.size() * sizeof(data[0])));
+		}
+
+		/*
+		Read count elements into data a block at a time, so a count
+		from a damaged header cannot allocate more than the stream holds.
+		*/
+		template<typename T>
+		static auto read_checked(std::istream& is, std::vector<T>& data, std::uint64_t count) -> void {
+			auto constexpr block = std::uint64_t{1} << 16;
+			data.clear();
+			while (is && data.size() < count) {
+				auto const start = data.size();
+				data.resize(start + static_cast<std::size_t>(std::min(block, count - start)));
+				is.read(reinterpret_cast<char*>(data.data() + start),
+				        static_cast<std::streamsize>((data.size() - start) * sizeof(T)));
+			}
+		}
+
+		template<typename Container>
+		static auto read(std::istream& is, Container& data) -> void {
+			is.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(data[0])));
+		}
+	};
+
+	template<typename N, typename E>
+	contraction_hierarchy(csr<N, E> const&) -> contraction_hierarchy<E>;
+
+	template<typename N, typename E>
+	contraction_hierarchy(graph<N, E> const&) -> contraction_hierarchy<E>;
+} // namespace gdwg
+
+#endif // GDWG_CONTRACTION_HIERARCHY_HPP
@@ -0,0 +1,167 @@
+#ifndef GDWG_CSR_HPP
+#define GDWG_CSR_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// Dense id of a node in a csr, i.e. its position in graph::nodes()
+	using node_id = std::uint32_t;
+
+	// Marks "no node", e.g. the predecessor of an unreached node
+	inline constexpr node_id no_node = std::numeric_limits<node_id>::max();
+
+	/*
+	Compressed sparse row snapshot of a graph.
+	Nodes get dense ids 0 .. size() - 1 in ascending order, so id i is
+	graph::nodes()[i]. The outgoing edges of node u are the contiguous
+	slice [offsets()[u], offsets()[u + 1]) of targets() and weights(),
+	ordered by target id then weight, exactly as the graph orders them.
+	The snapshot owns copies of the nodes and weights and does not
+	change when the graph does.
+	*/
+	template<typename N, typename E>
+	class csr {
+	public:
+		csr() = default;
+
+		/*
+		Build the snapshot in one pass over the graph.
+		Throw runtime error if the graph has too many nodes for node_id
+		Time Complexity : O(n+e)
+		*/
+		explicit csr(graph<N, E> const& g) {
+			if (g.graph_.size() >= no_node) {
+				auto error_msg = "Cannot call gdwg::csr on a graph with more nodes than node_id can number";
+				throw std::runtime_error(error_msg);
+			}
+			auto index = std::unordered_map<N const*, node_id>{};
+			index.reserve(g.graph_.size());
+			nodes_.reserve(g.graph_.size());
+			offsets_.reserve(g.graph_.size() + 1);
+			for (auto const& i : g.graph_) {
+				index.emplace(i.first.get(), static_cast<node_id>(nodes_.size()));
+				nodes_.push_back(*(i.first));
+				offsets_.push_back(offsets_.back() + i.second.size());
+			}
+			targets_.reserve(offsets_.back());
+			weights_.reserve(offsets_.back());
+			for (auto const& i : g.graph_) {
+				for (auto const& e : i.second) {
+					targets_.push_back(index.find(e.dst)->second);
+					weights_.push_back(*(e.weight));
+				}
+			}
+		}
+
+		// Number of nodes
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return nodes_.size();
+		}
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return targets_.size();
+		}
+
+		[[nodiscard]] auto node(node_id u) const -> N const& {
+			return nodes_[u];
+		}
+
+		[[nodiscard]] auto nodes() const noexcept -> std::vector<N> const& {
+			return nodes_;
+		}
+
+		/*
+		Return the id of value.
+		Throw runtime error if value is not a node of the snapshot
+		Time Complexity : O(log(n))
+		*/
+		[[nodiscard]] auto id(N const& value) const -> node_id {
+			auto const it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (it == nodes_.end() || value < *it) {
+				auto error_msg = "Cannot call gdwg::csr<N, E>::id on a node that doesn't exist";
+				throw std::runtime_error(error_msg);
+			}
+			return static_cast<node_id>(it - nodes_.begin());
+		}
+
+		[[nodiscard]] auto contains(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		}
+
+		[[nodiscard]] auto degree(node_id u) const -> std::size_t {
+			return offsets_[u + 1] - offsets_[u];
+		}
+
+		// Targets of the outgoing edges of u
+		[[nodiscard]] auto neighbours(node_id u) const -> std::span<node_id const> {
+			return {targets_.data() + offsets_[u], degree(u)};
+		}
+
+		// Weights of the outgoing edges of u, parallel to neighbours(u)
+		[[nodiscard]] auto weights(node_id u) const -> std::span<E const> {
+			return {weights_.data() + offsets_[u], degree(u)};
+		}
+
+		[[nodiscard]] auto offsets() const noexcept -> std::vector<std::size_t> const& {
+			return offsets_;
+		}
+
+		[[nodiscard]] auto targets() const noexcept -> std::vector<node_id> const& {
+			return targets_;
+		}
+
+		[[nodiscard]] auto weights() const noexcept -> std::vector<E> const& {
+			return weights_;
+		}
+
+		/*
+		Return the snapshot with every edge reversed, i.e. the
+		incoming edges of each node, built with a counting sort.
+		Time Complexity : O(n+e)
+		*/
+		[[nodiscard]] auto transpose() const -> csr {
+			auto ret = csr();
+			ret.nodes_ = nodes_;
+			ret.offsets_.assign(size() + 1, 0);
+			for (auto const v : targets_) {
+				++ret.offsets_[v + 1];
+			}
+			for (auto v = std::size_t{0}; v < size(); ++v) {
+				ret.offsets_[v + 1] += ret.offsets_[v];
+			}
+			ret.targets_.resize(num_edges());
+			ret.weights_.resize(num_edges());
+			auto cursor = std::vector<std::size_t>(ret.offsets_.begin(), ret.offsets_.end() - 1);
+			// Sources are visited in ascending order, so each row stays sorted
+			for (auto u = node_id{0}; u < size(); ++u) {
+				for (auto k = offsets_[u]; k < offsets_[u + 1]; ++k) {
+					auto const slot = cursor[targets_[k]]++;
+					ret.targets_[slot] = u;
+					ret.weights_[slot] = weights_[k];
+				}
+			}
+			return ret;
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_ = {0};
+		std::vector<node_id> targets_;
+		std::vector<E> weights_;
+	};
+
+	template<typename N, typename E>
+	csr(graph<N, E> const&) -> csr<N, E>;
+} // namespace gdwg
+
+#endif // GDWG_CSR_HPP
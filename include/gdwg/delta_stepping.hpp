@@ -0,0 +1,245 @@
+#ifndef GDWG_DELTA_STEPPING_HPP
+#define GDWG_DELTA_STEPPING_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Single-source shortest paths by delta-stepping, for non-negative
+	arithmetic weights. Tentative distances are kept in buckets of width
+	delta: a short ring holds the buckets just ahead of the current one,
+	and any further ahead wait in an ordered map until the ring reaches
+	them, so memory follows the graph rather than the weights. The
+	lowest non-empty bucket is emptied by relaxing light edges
+	(weight <= delta) until it stays empty, then the heavy edges of
+	every node it settled are relaxed once.
+
+	Nodes are owned by thread v % threads. In each phase every thread
+	scans its own part of the bucket and sends relaxation requests to
+	the owner of the target. Each owner then applies its requests, so no
+	node is written by two threads and no locks are needed. Distances
+	are identical to dijkstra(); among equally short paths the chosen
+	predecessor may differ.
+
+	A small delta approaches Dijkstra (little wasted work, little
+	parallelism); a large one approaches Bellman-Ford.
+	Throw runtime error if delta is not positive, an edge has a
+	negative or non-finite weight, or distances could exceed the
+	bucket numbers
+	*/
+	template<typename N, typename E>
+	auto delta_stepping(csr<N, E> const& g, node_id src, E delta, std::size_t threads = 0) -> shortest_paths<E> {
+		if (!(E{} < delta)) {
+			auto error_msg = "Cannot call gdwg::delta_stepping with a delta that is not positive";
+			throw std::runtime_error(error_msg);
+		}
+		auto max_weight = E{};
+		for (auto const& w : g.weights()) {
+			if (w < E{}) {
+				auto error_msg = "Cannot call gdwg::delta_stepping on a graph with negative edge weights";
+				throw std::runtime_error(error_msg);
+			}
+			if constexpr (std::is_floating_point_v<E>) {
+				if (!std::isfinite(w)) {
+					auto error_msg = "Cannot call gdwg::delta_stepping on a graph with non-finite edge weights";
+					throw std::runtime_error(error_msg);
+				}
+			}
+			max_weight = std::max(max_weight, w);
+		}
+		if constexpr (std::is_floating_point_v<E>) {
+			// No distance exceeds n * max_weight, which must fit a bucket number
+			auto const limit = static_cast<E>(std::numeric_limits<std::size_t>::max() / 4);
+			if (!(max_weight / delta * static_cast<E>(g.size()) < limit)) {
+				auto error_msg = "Cannot call gdwg::delta_stepping with weights too large for delta";
+				throw std::runtime_error(error_msg);
+			}
+		}
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+
+		struct request {
+			node_id target;
+			E distance;
+			node_id from;
+		};
+
+		auto const n = g.size();
+		auto constexpr not_queued = static_cast<std::size_t>(-1);
+		auto ret = shortest_paths<E>{std::vector<E>(n, detail::infinity<E>()), std::vector<node_id>(n, no_node)};
+		// Bucket each node is currently queued in
+		auto queued = std::vector<std::size_t>(n, not_queued);
+		auto const bucket_of = [delta](E const& d) { return static_cast<std::size_t>(d / delta); };
+		// Bucket being emptied
+		auto current = std::size_t{0};
+		// Buckets current to current + slots - 1 are kept in ring slot
+		// b % slots. A light edge reaches at most two buckets on, so a few
+		// times that keeps light work in the ring; slots is also no more
+		// than the furthest any edge can reach, when that is shorter.
+		auto const slots = std::min(bucket_of(max_weight) + 3, std::size_t{64});
+		// ring[owner][slot], far[owner][bucket]
+		auto ring = std::vector<std::vector<std::vector<node_id>>>(threads, std::vector<std::vector<node_id>>(slots));
+		auto far = std::vector<std::map<std::size_t, std::vector<node_id>>>(threads);
+		auto frontier = std::vector<std::vector<node_id>>(threads);
+		auto settled = std::vector<std::vector<node_id>>(threads);
+		// requests[sender][owner]
+		auto requests = std::vector<std::vector<std::vector<request>>>(threads, std::vector<std::vector<request>>(threads));
+
+		auto const owner = [threads](node_id v) { return v % threads; };
+		auto const enqueue = [&](std::size_t o, node_id v, E const& d) {
+			auto const b = bucket_of(d);
+			if (queued[v] == b) {
+				return;
+			}
+			if (b < current + slots) {
+				ring[o][b % slots].push_back(v);
+			}
+			else {
+				far[o][b].push_back(v);
+			}
+			queued[v] = b;
+		};
+		auto const for_each_owner = [threads](auto&& fn) {
+			detail::parallel_for(threads, threads, [&fn](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto o = begin; o < end; ++o) {
+					fn(o);
+				}
+			});
+		};
+		// Send a request for every edge of the given nodes that passes keep
+		auto const relax = [&](std::vector<std::vector<node_id>> const& from, auto keep) {
+			for_each_owner([&](std::size_t o) {
+				for (auto& out : requests[o]) {
+					out.clear();
+				}
+				for (auto const u : from[o]) {
+					auto const& weights = g.weights(u);
+					auto const& targets = g.neighbours(u);
+					for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+						if (keep(weights[k])) {
+							auto const v = targets[k];
+							requests[o][owner(v)].push_back({v, ret.distance[u] + weights[k], u});
+						}
+					}
+				}
+			});
+			for_each_owner([&](std::size_t o) {
+				for (auto const& in : requests) {
+					for (auto const& [v, d, u] : in[o]) {
+						if (d < ret.distance[v]) {
+							ret.distance[v] = d;
+							ret.predecessor[v] = u;
+							enqueue(o, v, d);
+						}
+					}
+				}
+			});
+		};
+		auto const light = [delta](E const& w) { return !(delta < w); };
+		auto const heavy = [delta](E const& w) { return delta < w; };
+
+		ret.distance[src] = E{};
+		ret.predecessor[src] = src;
+		enqueue(owner(src), src, E{});
+
+		// Move far buckets that the ring now covers into it
+		auto const pull_far = [&] {
+			for (auto o = std::size_t{0}; o < threads; ++o) {
+				auto& own = far[o];
+				while (!own.empty() && own.begin()->first < current + slots) {
+					auto& slot = ring[o][own.begin()->first % slots];
+					slot.insert(slot.end(), own.begin()->second.begin(), own.begin()->second.end());
+					own.erase(own.begin());
+				}
+			}
+		};
+
+		for (;; ++current) {
+			// Find the lowest non-empty bucket from current onwards: first
+			// within the ring, then at the nearest far bucket
+			pull_far();
+			auto found = false;
+			for (auto const last = current + slots; !found && current < last; ++current) {
+				for (auto const& own : ring) {
+					found = found || !own[current % slots].empty();
+				}
+				if (found) {
+					break;
+				}
+			}
+			if (!found) {
+				auto nearest = std::numeric_limits<std::size_t>::max();
+				for (auto const& own : far) {
+					if (!own.empty()) {
+						nearest = std::min(nearest, own.begin()->first);
+					}
+				}
+				if (nearest == std::numeric_limits<std::size_t>::max()) {
+					break;
+				}
+				current = nearest;
+			}
+			pull_far();
+			auto const b = current;
+
+			for (auto& s : settled) {
+				s.clear();
+			}
+			// Light edges can refill bucket b, so repeat until it stays empty
+			while (true) {
+				auto empty = true;
+				for (auto o = std::size_t{0}; o < threads; ++o) {
+					frontier[o].clear();
+					frontier[o].swap(ring[o][b % slots]);
+					empty = empty && frontier[o].empty();
+				}
+				if (empty) {
+					break;
+				}
+				// Drop stale entries of nodes that have since moved bucket
+				for_each_owner([&](std::size_t o) {
+					auto& f = frontier[o];
+					std::erase_if(f, [&](node_id v) { return queued[v] != b; });
+					for (auto const v : f) {
+						queued[v] = not_queued;
+					}
+					settled[o].insert(settled[o].end(), f.begin(), f.end());
+				});
+				relax(frontier, light);
+			}
+			relax(settled, heavy);
+		}
+		return ret;
+	}
+
+	/*
+	Delta-stepping shortest paths from src over g.
+	Results are indexed by node id, i.e. by position in g.nodes().
+	Throw runtime error if is_node(src) is false
+	*/
+	template<typename N, typename E>
+	auto delta_stepping(graph<N, E> const& g, N const& src, E delta, std::size_t threads = 0)
+	   -> shortest_paths<E> {
+		if (!g.is_node(src)) {
+			auto error_msg = "Cannot call gdwg::delta_stepping if src doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return delta_stepping(snapshot, snapshot.id(src), delta, threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_DELTA_STEPPING_HPP
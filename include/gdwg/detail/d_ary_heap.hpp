@@ -0,0 +1,152 @@
+#ifndef GDWG_DETAIL_D_ARY_HEAP_HPP
+#define GDWG_DETAIL_D_ARY_HEAP_HPP
+
+#include "gdwg/csr.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace gdwg::detail {
+	/*
+	Indexed d-ary min-heap of node ids keyed by Key, with decrease-key.
+	A wider node than a binary heap gives a shallower tree and fewer
+	cache misses on sift_down, which dominates in Dijkstra-like searches.
+	clear() only touches the entries still in the heap, so one heap can
+	be reused across many searches without reallocating.
+	*/
+	template<typename Key, std::size_t D = 4>
+	class d_ary_heap {
+	public:
+		d_ary_heap() = default;
+
+		explicit d_ary_heap(std::size_t n)
+		: position_(n, no_node) {}
+
+		// Make room for ids 0 .. n - 1. The heap must be empty.
+		auto resize(std::size_t n) -> void {
+			position_.assign(n, no_node);
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return heap_.empty();
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return heap_.size();
+		}
+
+		[[nodiscard]] auto contains(node_id v) const -> bool {
+			return position_[v] != no_node;
+		}
+
+		[[nodiscard]] auto top() const -> std::pair<node_id, Key> const& {
+			return heap_.front();
+		}
+
+		/*
+		Insert v with key, or lower the key of v if it is already
+		in the heap with a larger one.
+		*/
+		auto push_or_decrease(node_id v, Key const& key) -> void {
+			auto i = position_[v];
+			if (i == no_node) {
+				i = static_cast<node_id>(heap_.size());
+				heap_.emplace_back(v, key);
+				position_[v] = i;
+			}
+			else if (key < heap_[i].second) {
+				heap_[i].second = key;
+			}
+			else {
+				return;
+			}
+			sift_up(i);
+		}
+
+		/*
+		Set the key of v, which must be in the heap, up or down.
+		*/
+		auto update(node_id v, Key const& key) -> void {
+			auto const i = position_[v];
+			auto const raise = heap_[i].second < key;
+			heap_[i].second = key;
+			if (raise) {
+				sift_down(i);
+			}
+			else {
+				sift_up(i);
+			}
+		}
+
+		auto pop() -> std::pair<node_id, Key> {
+			auto ret = std::move(heap_.front());
+			position_[ret.first] = no_node;
+			if (heap_.size() > 1) {
+				heap_.front() = std::move(heap_.back());
+				position_[heap_.front().first] = 0;
+				heap_.pop_back();
+				sift_down(0);
+			}
+			else {
+				heap_.pop_back();
+			}
+			return ret;
+		}
+
+		auto clear() -> void {
+			for (auto const& [v, key] : heap_) {
+				position_[v] = no_node;
+			}
+			heap_.clear();
+		}
+
+	private:
+		std::vector<std::pair<node_id, Key>> heap_;
+		std::vector<node_id> position_;
+
+		auto place(node_id i, std::pair<node_id, Key>&& entry) -> void {
+			position_[entry.first] = i;
+			heap_[i] = std::move(entry);
+		}
+
+		auto sift_up(node_id i) -> void {
+			auto entry = std::move(heap_[i]);
+			while (i > 0) {
+				auto const parent = static_cast<node_id>((i - 1) / D);
+				if (!(entry.second < heap_[parent].second)) {
+					break;
+				}
+				place(i, std::move(heap_[parent]));
+				i = parent;
+			}
+			place(i, std::move(entry));
+		}
+
+		auto sift_down(node_id i) -> void {
+			auto entry = std::move(heap_[i]);
+			auto const n = heap_.size();
+			while (true) {
+				auto const first = std::size_t{i} * D + 1;
+				if (first >= n) {
+					break;
+				}
+				auto best = first;
+				auto const last = std::min(first + D, n);
+				for (auto c = first + 1; c < last; ++c) {
+					if (heap_[c].second < heap_[best].second) {
+						best = c;
+					}
+				}
+				if (!(heap_[best].second < entry.second)) {
+					break;
+				}
+				place(i, std::move(heap_[best]));
+				i = static_cast<node_id>(best);
+			}
+			place(i, std::move(entry));
+		}
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_D_ARY_HEAP_HPP
@@ -0,0 +1,71 @@
+#ifndef GDWG_DETAIL_PARALLEL_HPP
+#define GDWG_DETAIL_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/*
+Small threading helpers shared by the parallel graph algorithms.
+Nothing in here is part of the public interface.
+*/
+namespace gdwg::detail {
+	/*
+	Number of threads to use when the caller asks for 0,
+	never less than one.
+	*/
+	inline auto default_threads() -> std::size_t {
+		auto const n = std::thread::hardware_concurrency();
+		return n == 0 ? 1 : n;
+	}
+
+	/*
+	Split [0, n) into at most threads contiguous chunks and call
+	fn(begin, end, thread_index) on each chunk in its own thread.
+	A thread count of 0 means default_threads().
+	With a single chunk fn is called on the calling thread.
+	The first exception thrown by any chunk is rethrown once all
+	threads have joined.
+	*/
+	template<typename F>
+	auto parallel_for(std::size_t n, std::size_t threads, F&& fn) -> void {
+		if (threads == 0) {
+			threads = default_threads();
+		}
+		threads = std::max<std::size_t>(1, std::min(threads, n));
+		if (threads == 1) {
+			fn(std::size_t{0}, n, std::size_t{0});
+			return;
+		}
+
+		auto errors = std::vector<std::exception_ptr>(threads);
+		auto workers = std::vector<std::thread>{};
+		workers.reserve(threads);
+		auto const chunk = n / threads;
+		auto const extra = n % threads;
+		auto begin = std::size_t{0};
+		for (auto t = std::size_t{0}; t < threads; ++t) {
+			auto const end = begin + chunk + (t < extra ? 1 : 0);
+			workers.emplace_back([&fn, &errors, begin, end, t] {
+				try {
+					fn(begin, end, t);
+				} catch (...) {
+					errors[t] = std::current_exception();
+				}
+			});
+			begin = end;
+		}
+		for (auto& w : workers) {
+			w.join();
+		}
+		for (auto const& e : errors) {
+			if (e) {
+				std::rethrow_exception(e);
+			}
+		}
+	}
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_PARALLEL_HPP
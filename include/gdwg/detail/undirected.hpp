@@ -0,0 +1,60 @@
+#ifndef GDWG_DETAIL_UNDIRECTED_HPP
+#define GDWG_DETAIL_UNDIRECTED_HPP
+
+#include "gdwg/csr.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace gdwg::detail {
+	/*
+	The simple undirected graph underlying a csr: u and v are
+	neighbours if there is an edge between them in either direction.
+	Parallel edges collapse, self-loops are dropped, and every
+	neighbour list is sorted by id.
+	*/
+	class undirected_adjacency {
+	public:
+		// reverse must be g.transpose()
+		template<typename N, typename E>
+		undirected_adjacency(csr<N, E> const& g, csr<N, E> const& reverse)
+		: offsets_(g.size() + 1, 0) {
+			neighbours_.reserve(2 * g.num_edges());
+			for (auto u = node_id{0}; u < g.size(); ++u) {
+				// Both lists are sorted by id, so merge them dropping repeats
+				auto const out = g.neighbours(u);
+				auto const in = reverse.neighbours(u);
+				auto i = out.begin();
+				auto j = in.begin();
+				auto last = no_node;
+				while (i != out.end() || j != in.end()) {
+					auto const v = (j == in.end() || (i != out.end() && *i < *j)) ? *i++ : *j++;
+					if (v != u && v != last) {
+						neighbours_.push_back(v);
+						last = v;
+					}
+				}
+				offsets_[u + 1] = neighbours_.size();
+			}
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return offsets_.size() - 1;
+		}
+
+		[[nodiscard]] auto degree(node_id u) const -> std::size_t {
+			return offsets_[u + 1] - offsets_[u];
+		}
+
+		[[nodiscard]] auto neighbours(node_id u) const -> std::span<node_id const> {
+			return {neighbours_.data() + offsets_[u], degree(u)};
+		}
+
+	private:
+		std::vector<std::size_t> offsets_;
+		std::vector<node_id> neighbours_;
+	};
+} // namespace gdwg::detail
+
+#endif // GDWG_DETAIL_UNDIRECTED_HPP
@@ -0,0 +1,85 @@
+#ifndef GDWG_DIJKSTRA_HPP
+#define GDWG_DIJKSTRA_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <stdexcept>
+
+namespace gdwg {
+	/*
+	Single-source shortest paths over a csr snapshot, using an
+	indexed 4-ary heap over dense node ids.
+	If target is given the search stops as soon as target is settled;
+	only target and the nodes settled before it then hold final
+	distances.
+	Throw runtime error if an edge with a negative weight is relaxed
+	Time Complexity : O((n+e)log(n))
+	*/
+	template<typename N, typename E>
+	auto dijkstra(csr<N, E> const& g, node_id src, node_id target = no_node) -> shortest_paths<E> {
+		auto ret = shortest_paths<E>{std::vector<E>(g.size(), detail::infinity<E>()),
+		                             std::vector<node_id>(g.size(), no_node)};
+		auto heap = detail::d_ary_heap<E>(g.size());
+		ret.distance[src] = E{};
+		ret.predecessor[src] = src;
+		heap.push_or_decrease(src, E{});
+
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto const& weights = g.weights();
+		while (!heap.empty()) {
+			auto const [u, d] = heap.pop();
+			if (u == target) {
+				break;
+			}
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+				if (weights[k] < E{}) {
+					auto error_msg = "Cannot call gdwg::dijkstra on a graph with negative edge weights";
+					throw std::runtime_error(error_msg);
+				}
+				auto const v = targets[k];
+				auto const candidate = d + weights[k];
+				if (candidate < ret.distance[v]) {
+					ret.distance[v] = candidate;
+					ret.predecessor[v] = u;
+					heap.push_or_decrease(v, candidate);
+				}
+			}
+		}
+		return ret;
+	}
+
+	/*
+	Shortest paths from src to every node of g.
+	Results are indexed by node id, i.e. by position in g.nodes().
+	Throw runtime error if is_node(src) is false
+	*/
+	template<typename N, typename E>
+	auto dijkstra(graph<N, E> const& g, N const& src) -> shortest_paths<E> {
+		if (!g.is_node(src)) {
+			auto error_msg = "Cannot call gdwg::dijkstra if src doesn't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return dijkstra(snapshot, snapshot.id(src));
+	}
+
+	/*
+	Shortest path from src to dst, stopping once dst is settled.
+	Throw runtime error if either of is_node(src) or is_node(dst) are false
+	*/
+	template<typename N, typename E>
+	auto dijkstra(graph<N, E> const& g, N const& src, N const& dst) -> shortest_paths<E> {
+		if (!g.is_node(src) || !g.is_node(dst)) {
+			auto error_msg = "Cannot call gdwg::dijkstra if src or dst node don't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return dijkstra(snapshot, snapshot.id(src), snapshot.id(dst));
+	}
+} // namespace gdwg
+
+#endif // GDWG_DIJKSTRA_HPP
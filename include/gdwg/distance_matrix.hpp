@@ -0,0 +1,69 @@
+#ifndef GDWG_DISTANCE_MATRIX_HPP
+#define GDWG_DISTANCE_MATRIX_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Result of an all-pairs shortest path search: an n by n row-major
+	matrix where (u, v) is the distance from node id u to node id v,
+	i.e. rows and columns follow the order of g.nodes().
+	Unreached pairs hold detail::infinity<E>().
+	*/
+	template<typename E>
+	class distance_matrix {
+	public:
+		distance_matrix() = default;
+
+		explicit distance_matrix(std::size_t n)
+		: size_{n}
+		, distance_(n * n, detail::infinity<E>()) {}
+
+		distance_matrix(std::size_t n, std::vector<E> distance)
+		: size_{n}
+		, distance_{std::move(distance)} {}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		}
+
+		[[nodiscard]] auto operator()(node_id u, node_id v) const -> E const& {
+			return distance_[u * size_ + v];
+		}
+
+		[[nodiscard]] auto operator()(node_id u, node_id v) -> E& {
+			return distance_[u * size_ + v];
+		}
+
+		// Distances from u to every node
+		[[nodiscard]] auto row(node_id u) const -> std::span<E const> {
+			return {distance_.data() + u * size_, size_};
+		}
+
+		[[nodiscard]] auto row(node_id u) -> std::span<E> {
+			return {distance_.data() + u * size_, size_};
+		}
+
+		[[nodiscard]] auto reached(node_id u, node_id v) const -> bool {
+			return (*this)(u, v) != detail::infinity<E>();
+		}
+
+		[[nodiscard]] auto data() const noexcept -> std::vector<E> const& {
+			return distance_;
+		}
+
+		auto operator==(distance_matrix const& other) const -> bool = default;
+
+	private:
+		std::size_t size_ = 0;
+		std::vector<E> distance_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_DISTANCE_MATRIX_HPP
@@ -0,0 +1,167 @@
+#ifndef GDWG_FLOYD_WARSHALL_HPP
+#define GDWG_FLOYD_WARSHALL_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/distance_matrix.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Side of the square tiles; three 64x64 tiles of doubles fit in L2
+		inline constexpr std::size_t floyd_warshall_block = 64;
+
+		/*
+		Marks an unreached pair while Floyd-Warshall runs. For integers
+		this is half the largest value, so adding any finite distance to
+		it cannot overflow; it becomes infinity<E>() again afterwards.
+		Sums are likewise kept above minus this value, so a negative
+		cycle cannot drive them past the smallest value before it is
+		reported; integer weights must stay within the same bounds.
+		*/
+		template<typename E>
+		constexpr auto floyd_warshall_unreached() -> E {
+			if constexpr (std::numeric_limits<E>::has_infinity) {
+				return std::numeric_limits<E>::infinity();
+			}
+			else {
+				return std::numeric_limits<E>::max() / 2;
+			}
+		}
+
+		/*
+		dij[j] = min(dij[j], dik + dkj[j]) over one tile row.
+		Branch free over contiguous rows, so the compiler turns it into
+		vector min and add instructions.
+		*/
+		template<typename E>
+		auto min_plus_row(E* dij, E const* dkj, E dik, std::size_t len) -> void {
+			auto constexpr unreached = floyd_warshall_unreached<E>();
+			for (auto j = std::size_t{0}; j < len; ++j) {
+				if constexpr (std::numeric_limits<E>::has_infinity) {
+					dij[j] = std::min(dij[j], dik + dkj[j]);
+				}
+				else {
+					// A negative dik must not make an unreached dkj look reachable
+					auto through_k = dik + dkj[j];
+					if constexpr (std::is_signed_v<E>) {
+						through_k = std::max(through_k, -unreached);
+					}
+					dij[j] = std::min(dij[j], dkj[j] == unreached ? unreached : through_k);
+				}
+			}
+		}
+
+		/*
+		Relax tile (bi, bj) of the n by n matrix d through every k of
+		tile column bk, in increasing k so a tile may depend on itself.
+		*/
+		template<typename E>
+		auto floyd_warshall_tile(std::vector<E>& d, std::size_t n, std::size_t bi, std::size_t bj, std::size_t bk)
+		   -> void {
+			auto constexpr block = floyd_warshall_block;
+			auto const i_end = std::min(n, (bi + 1) * block);
+			auto const j_begin = bj * block;
+			auto const len = std::min(n, j_begin + block) - j_begin;
+			auto const k_end = std::min(n, (bk + 1) * block);
+			for (auto k = bk * block; k < k_end; ++k) {
+				auto const* dkj = d.data() + k * n + j_begin;
+				for (auto i = bi * block; i < i_end; ++i) {
+					auto const dik = d[i * n + k];
+					if (dik == floyd_warshall_unreached<E>()) {
+						continue;
+					}
+					min_plus_row(d.data() + i * n + j_begin, dkj, dik, len);
+				}
+			}
+		}
+	} // namespace detail
+
+	/*
+	All-pairs shortest paths by cache-blocked Floyd-Warshall.
+	The graph is copied into a dense matrix, keeping the smallest weight
+	over parallel edges, and processed in square tiles. For each tile
+	column k the diagonal tile is relaxed first, then the other tiles
+	of row and column k in parallel, then all remaining tiles in
+	parallel, each tile staying in cache while it is worked on.
+	Negative weights are allowed.
+	Throw runtime error if g has a negative cycle
+	Time Complexity : O(n^3), Space Complexity : O(n^2)
+	*/
+	template<typename N, typename E>
+	auto floyd_warshall(csr<N, E> const& g, std::size_t threads = 0) -> distance_matrix<E> {
+		auto constexpr unreached = detail::floyd_warshall_unreached<E>();
+		auto const n = g.size();
+		auto d = std::vector<E>(n * n, unreached);
+		for (auto u = node_id{0}; u < n; ++u) {
+			d[u * n + u] = E{};
+			auto const targets = g.neighbours(u);
+			auto const weights = g.weights(u);
+			for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+				auto& duv = d[u * n + targets[k]];
+				duv = std::min(duv, weights[k]);
+			}
+		}
+
+		auto const blocks = (n + detail::floyd_warshall_block - 1) / detail::floyd_warshall_block;
+		for (auto bk = std::size_t{0}; bk < blocks; ++bk) {
+			detail::floyd_warshall_tile(d, n, bk, bk, bk);
+			// Tiles [0, blocks) are row bk, tiles [blocks, 2*blocks) column bk
+			detail::parallel_for(2 * blocks, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto t = begin; t < end; ++t) {
+					auto const other = t % blocks;
+					if (other == bk) {
+						continue;
+					}
+					if (t < blocks) {
+						detail::floyd_warshall_tile(d, n, bk, other, bk);
+					}
+					else {
+						detail::floyd_warshall_tile(d, n, other, bk, bk);
+					}
+				}
+			});
+			detail::parallel_for(blocks * blocks, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto t = begin; t < end; ++t) {
+					auto const bi = t / blocks;
+					auto const bj = t % blocks;
+					if (bi != bk && bj != bk) {
+						detail::floyd_warshall_tile(d, n, bi, bj, bk);
+					}
+				}
+			});
+		}
+
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			if (d[u * n + u] < E{}) {
+				auto error_msg = "Cannot call gdwg::floyd_warshall on a graph with a negative cycle";
+				throw std::runtime_error(error_msg);
+			}
+		}
+		if constexpr (!std::numeric_limits<E>::has_infinity) {
+			std::replace(d.begin(), d.end(), unreached, detail::infinity<E>());
+		}
+		return distance_matrix<E>(n, std::move(d));
+	}
+
+	/*
+	All-pairs shortest paths over g.
+	Rows and columns follow the order of g.nodes().
+	Throw runtime error if g has a negative cycle
+	*/
+	template<typename N, typename E>
+	auto floyd_warshall(graph<N, E> const& g, std::size_t threads = 0) -> distance_matrix<E> {
+		return floyd_warshall(csr(g), threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_FLOYD_WARSHALL_HPP
@@ -1,17 +1,35 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <ranges>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "gdwg/detail/parallel.hpp"
+
 // This will not compile straight away
 namespace gdwg {
+	template<typename N, typename E, typename Pred>
+	class filtered_view;
+
+	template<typename N, typename E>
+	class reverse_view;
+
+	template<typename N, typename E>
+	class csr;
+
 	template<typename N, typename E>
 	class graph {
 	public:
@@ -21,12 +39,33 @@ namespace gdwg {
 			E weight;
 		};
 
+		/*
+		Flattened result of connections_batch.
+		The connections of the i-th queried node are
+		values[offsets[i]] .. values[offsets[i + 1]].
+		Reusing one buffer across batches keeps its capacity.
+		*/
+		struct connections_buffer {
+			std::vector<std::size_t> offsets;
+			std::vector<N> values;
+
+			[[nodiscard]] auto operator[](std::size_t i) const -> std::span<N const> {
+				return {values.data() + offsets[i], offsets[i + 1] - offsets[i]};
+			}
+
+			[[nodiscard]] auto size() const -> std::size_t {
+				return offsets.empty() ? 0 : offsets.size() - 1;
+			}
+		};
+
+		class iterator;
+
 		// Constructors
 		/*
 		Basic Constructor doing value initialization
 		*/
 		graph() noexcept
-		: graph_{std::map<std::unique_ptr<N>, std::set<Edges>>()} {}
+		: graph_{node_map()} {}
 
 		/*
 		Given an list of nodes, craete a graph based on that.
@@ -49,8 +88,7 @@ namespace gdwg {
 
 		// Move Constructor
 		graph(graph&& other) noexcept
-		: graph_{std::exchange(other.graph_,
-		                       std::map<std::unique_ptr<N>, std::set<Edges>>())} {}
+		: graph_{std::exchange(other.graph_, node_map())} {}
 
 		// Move Assignment
 		auto operator=(graph&& other) noexcept -> graph& {
@@ -89,7 +127,7 @@ namespace gdwg {
 			// If that node does not exist, it will be equal to the graph pointing
 			// to the last element
 			if (value_node == graph_.end()) {
-				graph_.emplace(std::make_unique<N>(value), std::set<Edges>());
+				graph_.emplace(std::make_unique<N>(value), edge_set());
 				return true;
 			}
 
@@ -112,11 +150,9 @@ namespace gdwg {
 			auto const& dst_node = get_node(dst);
 			auto const& edges = src_node -> second;
 
-			for (auto const& i : edges){
-				// If the given edge already exist, return false
-				if (*(i.weight) == weight && *(i.dst) == dst) {
-					return false;
-				}
+			// If the given edge already exist, return false
+			if (edges.find(EdgeKey{dst, weight}) != edges.end()) {
+				return false;
 			}
 			auto e1 = Edges();
 			e1.dst = dst_node -> first.get();
@@ -261,12 +297,7 @@ namespace gdwg {
 		else return false.
 		*/
 		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			for (auto const& i : graph_){
-				if (*(i.first) == value){
-					return true;
-				}
-			}
-			return false;
+			return get_node(value) != graph_.end();
 		}
 
 		/*
@@ -302,14 +333,44 @@ namespace gdwg {
 
 		/*
 		Return a sequence of nodes in ascending order.
+		Nodes are stored in order, so no sort is needed.
+		Time Complexity : O(n)
 		*/
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto ret = std::vector<N>{};
+			ret.reserve(graph_.size());
 			for_each(graph_.begin(), graph_.end(), [&ret](auto const& i) { ret.push_back(*(i.first)); });
-			std::sort(ret.begin(), ret.end());
 			return ret;
 		}
 
+		/*
+		Return a lazy range over the nodes in [lo, hi), in ascending order.
+		Nothing is copied; the range refers to the graph's own nodes and
+		is invalidated by any modification of the graph.
+		Time Complexity : O(log(n)+k) for k nodes in the range
+		*/
+		[[nodiscard]] auto nodes_in_range(N const& lo, N const& hi) const {
+			auto const first = graph_.lower_bound(lo);
+			auto const last = hi < lo ? first : graph_.lower_bound(hi);
+			return std::ranges::subrange(first, last) | std::views::transform(node_value);
+		}
+
+		/*
+		Return a lazy range over the nodes that start with prefix,
+		in ascending order. Only available for string-like N.
+		Nodes sharing a prefix are contiguous in the node index,
+		so this seeks to the first one and stops at the first node
+		that no longer matches.
+		Time Complexity : O(log(n)+k) for k matching nodes
+		*/
+		[[nodiscard]] auto nodes_with_prefix(N const& prefix) const
+		   requires requires(N const& n) { { n.starts_with(n) } -> std::convertible_to<bool>; }
+		{
+			auto const matches = [prefix](auto const& i) { return i.first->starts_with(prefix); };
+			return std::ranges::subrange(graph_.lower_bound(prefix), graph_.end())
+			       | std::views::take_while(matches) | std::views::transform(node_value);
+		}
+
 		/*
 		Return a sequence of edges from src to dst in ascending order
 		Throw runtime error if either of is_node(src) or is_node(dst) are false
@@ -353,6 +414,181 @@ namespace gdwg {
 			return ret;
 		}
 
+		/*
+		Same as calling connections(src) for every src in srcs,
+		but written into a single flattened buffer in the order of srcs.
+		The keys are sorted and the node index is walked once in order,
+		so the batch costs O(k log k + n + r) for k keys and r results
+		rather than k separate scans and allocations.
+		srcs must hold its elements (e.g. a container), as they are
+		referenced while the batch runs.
+		Throw runtime error if is_node(src) is false for any src
+		*/
+		template<typename Range>
+		auto connections_batch(Range const& srcs, connections_buffer& out) const -> void {
+			auto keys = std::vector<N const*>{};
+			for (auto const& src : srcs) {
+				keys.push_back(&src);
+			}
+			auto const nodes = resolve_sorted(keys);
+
+			out.offsets.clear();
+			out.values.clear();
+			out.offsets.reserve(keys.size() + 1);
+			out.offsets.push_back(0);
+			for (auto const& node : nodes) {
+				if (node == graph_.end()) {
+					auto error_msg = "Cannot call gdwg::graph<N, E>::connections_batch if src doesn't exist in the graph";
+					throw std::runtime_error(error_msg);
+				}
+				out.offsets.push_back(out.offsets.back() + node->second.size());
+			}
+			out.values.reserve(out.offsets.back());
+			// Edges are ordered by dst, so each run is already ascending
+			for (auto const& node : nodes) {
+				for (auto const& e : node->second) {
+					out.values.push_back(*(e.dst));
+				}
+			}
+		}
+
+		template<typename Range>
+		[[nodiscard]] auto connections_batch(Range const& srcs) const -> connections_buffer {
+			auto out = connections_buffer{};
+			connections_batch(srcs, out);
+			return out;
+		}
+
+		/*
+		Same as calling is_connected(src, dst) for every (src, dst) pair
+		in pairs, with the answers written to out in the order of pairs.
+		Pairs are sorted so each src is looked up once and its edges are
+		merged against the sorted dsts in a single pass.
+		As with connections_batch, pairs must hold its elements.
+		Throw runtime error if either of is_node(src) or is_node(dst)
+		are false for any pair
+		*/
+		template<typename Range>
+		auto is_connected_batch(Range const& pairs, std::vector<bool>& out) const -> void {
+			auto keys = std::vector<std::pair<N const*, N const*>>{};
+			for (auto const& [src, dst] : pairs) {
+				keys.emplace_back(&src, &dst);
+			}
+			auto order = std::vector<std::size_t>(keys.size());
+			for (auto i = std::size_t{0}; i < order.size(); ++i) {
+				order[i] = i;
+			}
+			std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+				auto const& [a_src, a_dst] = keys[a];
+				auto const& [b_src, b_dst] = keys[b];
+				if (*a_src < *b_src || *b_src < *a_src) {
+					return *a_src < *b_src;
+				}
+				return *a_dst < *b_dst;
+			});
+
+			out.assign(keys.size(), false);
+			auto node = graph_.begin();
+			auto edge = typename edge_set::const_iterator();
+			for (auto k = std::size_t{0}; k < order.size(); ++k) {
+				auto const& [src, dst] = keys[order[k]];
+				// Start a new src group
+				if (k == 0 || *(keys[order[k - 1]].first) < *src) {
+					node = seek_node(node, *src);
+					if (node != graph_.end()) {
+						edge = node->second.begin();
+					}
+				}
+				if (node == graph_.end() || *(node->first) < *src || *src < *(node->first)
+				    || !is_node(*dst)) {
+					auto error_msg = "Cannot call gdwg::graph<N, E>::is_connected_batch if src or dst node don't exist in the graph";
+					throw std::runtime_error(error_msg);
+				}
+				while (edge != node->second.end() && *(edge->dst) < *dst) {
+					++edge;
+				}
+				out[order[k]] = edge != node->second.end() && !(*dst < *(edge->dst));
+			}
+		}
+
+		template<typename Range>
+		[[nodiscard]] auto is_connected_batch(Range const& pairs) const -> std::vector<bool> {
+			auto out = std::vector<bool>{};
+			is_connected_batch(pairs, out);
+			return out;
+		}
+
+		/*
+		Return a new graph with every edge src->dst reversed into dst->src.
+		Edges are bucketed by their new src with a counting pass
+		(count in-degrees, compute offsets, scatter), and each bucket is
+		already in ascending order, so every insert is at the end of its set.
+		Time Complexity : O(n+e)
+		*/
+		[[nodiscard]] auto transpose() const -> graph {
+			return transpose(1);
+		}
+
+		/*
+		Same as transpose(), but the edge sets of the new graph are built
+		by up to threads threads, each owning a contiguous range of nodes.
+		A thread count of 0 uses every available core.
+		*/
+		[[nodiscard]] auto transpose(std::size_t threads) const -> graph {
+			auto ret = graph();
+			auto const n = graph_.size();
+
+			// Copy the nodes in order and remember where each one went
+			auto index = std::unordered_map<N const*, std::size_t>{};
+			index.reserve(n);
+			auto new_nodes = std::vector<typename node_map::iterator>{};
+			new_nodes.reserve(n);
+			for (auto const& i : graph_) {
+				index.emplace(i.first.get(), new_nodes.size());
+				new_nodes.push_back(
+				   ret.graph_.emplace_hint(ret.graph_.end(), std::make_unique<N>(*(i.first)), edge_set()));
+			}
+
+			// Count in-degrees, turn them into offsets, then scatter
+			// (src, weight) pairs into the bucket of their dst
+			auto offsets = std::vector<std::size_t>(n + 1, 0);
+			auto dst_index = std::vector<std::size_t>{};
+			for (auto const& i : graph_) {
+				for (auto const& e : i.second) {
+					dst_index.push_back(index.find(e.dst)->second);
+					++offsets[dst_index.back() + 1];
+				}
+			}
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				offsets[v + 1] += offsets[v];
+			}
+			auto buckets = std::vector<std::pair<std::size_t, E const*>>(dst_index.size());
+			auto cursor = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+			auto next = dst_index.begin();
+			auto src = std::size_t{0};
+			for (auto const& i : graph_) {
+				for (auto const& e : i.second) {
+					buckets[cursor[*next++]++] = {src, e.weight.get()};
+				}
+				++src;
+			}
+
+			// Sources are visited in ascending order and weights for the
+			// same (src, dst) are already sorted, so append with an end hint
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto v = begin; v < end; ++v) {
+					auto& edges = new_nodes[v]->second;
+					for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+						auto e = Edges();
+						e.dst = new_nodes[buckets[k].first]->first.get();
+						e.weight = std::make_unique<E>(*(buckets[k].second));
+						edges.insert(edges.end(), std::move(e));
+					}
+				}
+			});
+			return ret;
+		}
+
 		// Comparisons
 		/*
 		Given other graph, compare it with this* and return true if they are same,
@@ -404,9 +640,90 @@ namespace gdwg {
 			return os;
 		}
 
+		// Iterator access
+		/*
+		Return an iterator to the first edge, ordered by src, dst and weight.
+		Nodes without any outgoing edges are not traversed.
+		*/
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(graph_.begin(), graph_.end());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(graph_.end(), graph_.end());
+		}
+
+		/*
+		Return an iterator to the edge src->dst with weight weight,
+		or end() if no such edge exists.
+		Time Complexity : O(log(n)+e)
+		*/
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const& src_node = get_node(src);
+			if (src_node == graph_.end()) {
+				return end();
+			}
+			auto const& edges = src_node->second;
+			auto const& e = edges.find(EdgeKey{dst, weight});
+			if (e == edges.end()) {
+				return end();
+			}
+			return iterator(src_node, graph_.end(), e);
+		}
+
+		/*
+		Return an iterator to the first edge that comes after src->dst
+		with weight weight in iteration order, or end() if there is none.
+		The edge itself does not need to exist, nor do src and dst,
+		so a cursor stays usable after its edge has been erased.
+		Time Complexity : O(log(n)+log(e))
+		*/
+		[[nodiscard]] auto upper_bound(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto const& src_node = graph_.lower_bound(src);
+			if (src_node == graph_.end()) {
+				return end();
+			}
+			// src is not a node, so every edge of the next node comes after it
+			if (src < *(src_node->first)) {
+				return iterator(src_node, graph_.end());
+			}
+			auto const& edges = src_node->second;
+			auto const& e = edges.upper_bound(EdgeKey{dst, weight});
+			if (e == edges.end()) {
+				return iterator(std::next(src_node), graph_.end());
+			}
+			return iterator(src_node, graph_.end(), e);
+		}
+
+		/*
+		Return the next page of at most limit edges that come after
+		src->dst with weight weight. Passing the last edge of a page
+		back in resumes the enumeration where it stopped.
+		Time Complexity : O(log(n)+log(e)+limit)
+		*/
+		[[nodiscard]] auto edges_after(N const& src, N const& dst, E const& weight, std::size_t limit) const
+		   -> std::vector<value_type> {
+			return edges_page(upper_bound(src, dst, weight), limit);
+		}
 
+		/*
+		Return the first page of at most limit edges,
+		to be continued with edges_after.
+		*/
+		[[nodiscard]] auto first_edges(std::size_t limit) const -> std::vector<value_type> {
+			return edges_page(begin(), limit);
+		}
 
 	private:
+		template<typename, typename, typename>
+		friend class filtered_view;
+
+		template<typename, typename>
+		friend class reverse_view;
+
+		template<typename, typename>
+		friend class csr;
+
 		struct Edges {
 			N* dst;
 			std::unique_ptr<E> weight;
@@ -418,6 +735,9 @@ namespace gdwg {
 			Edges(Edges const& other)
 			: dst{other.dst}, weight{std::make_unique<E>(*(other.weight))} {}
 
+			// Move the weight instead of copying it
+			Edges(Edges&& other) noexcept = default;
+
 			// Compare two edge in constant time in order to achieve time complexity
 			auto operator<(const Edges& other) const {
 				if (*(dst) != *(other.dst)){
@@ -428,26 +748,216 @@ namespace gdwg {
 
 		};
 
+		// Order nodes by value rather than by address, so that the graph,
+		// nodes() and the iterator all see nodes in ascending order.
+		// Transparent so that lookups can be done with a plain N.
+		struct NodeCompare {
+			using is_transparent = void;
+
+			auto operator()(std::unique_ptr<N> const& a, std::unique_ptr<N> const& b) const -> bool {
+				return *a < *b;
+			}
+
+			auto operator()(std::unique_ptr<N> const& a, N const& b) const -> bool {
+				return *a < b;
+			}
+
+			auto operator()(N const& a, std::unique_ptr<N> const& b) const -> bool {
+				return a < *b;
+			}
+		};
+
+		// Looks up an edge by (dst, weight) without building an Edges
+		struct EdgeKey {
+			N const& dst;
+			E const& weight;
+		};
+
+		// Orders edges by dst then weight, transparent over EdgeKey
+		struct EdgeCompare {
+			using is_transparent = void;
+
+			auto operator()(Edges const& a, Edges const& b) const -> bool {
+				return a < b;
+			}
+
+			auto operator()(Edges const& a, EdgeKey const& b) const -> bool {
+				if (*(a.dst) != b.dst) {
+					return *(a.dst) < b.dst;
+				}
+				return *(a.weight) < b.weight;
+			}
+
+			auto operator()(EdgeKey const& a, Edges const& b) const -> bool {
+				if (a.dst != *(b.dst)) {
+					return a.dst < *(b.dst);
+				}
+				return a.weight < *(b.weight);
+			}
+		};
+
+		using edge_set = std::set<Edges, EdgeCompare>;
+		using node_map = std::map<std::unique_ptr<N>, edge_set, NodeCompare>;
+
 		// graph initialization here
-		std::map<std::unique_ptr<N>, std::set<Edges>> graph_;
+		node_map graph_;
+
+		// Collect at most limit edges starting at first
+		auto edges_page(iterator first, std::size_t limit) const -> std::vector<value_type> {
+			auto ret = std::vector<value_type>{};
+			for (auto const last = end(); first != last && ret.size() < limit; ++first) {
+				ret.push_back(*first);
+			}
+			return ret;
+		}
+
+		// Projects a node index entry to its value
+		static auto node_value(typename node_map::value_type const& i) -> N const& {
+			return *(i.first);
+		}
 
 		//helper functions to find the node
-		auto get_node(N const& value) const ->
-		   typename std::map<std::unique_ptr<N>, std::set<Edges>>::const_iterator {
-			return std::find_if(graph_.begin(), graph_.end(), [&value](auto const& i) {
-				return *(i.first) == value;
-			});
+		auto get_node(N const& value) const -> typename node_map::const_iterator {
+			return graph_.find(value);
 		}
 
 		//helper functions to find the node
-		auto get_node(N const& value) ->
-		   typename std::map<std::unique_ptr<N>, std::set<Edges>>::iterator {
-			return std::find_if(graph_.begin(), graph_.end(), [&value](auto const& i) {
-				return *(i.first) == value;
+		auto get_node(N const& value) -> typename node_map::iterator {
+			return graph_.find(value);
+		}
+
+		/*
+		Advance from it to the first node not less than value.
+		Nearby nodes are reached by stepping forward, distant ones
+		with a fresh O(log(n)) lookup, so a sorted sequence of keys
+		walks the node index once.
+		*/
+		auto seek_node(typename node_map::const_iterator it, N const& value) const ->
+		   typename node_map::const_iterator {
+			for (auto step = 0; step < 8; ++step) {
+				if (it == graph_.end() || !(*(it->first) < value)) {
+					return it;
+				}
+				++it;
+			}
+			return graph_.lower_bound(value);
+		}
+
+		/*
+		Look up every key, visiting them in ascending order.
+		Returns the node of each key in the original order of keys,
+		or graph_.end() for keys that are not nodes.
+		*/
+		auto resolve_sorted(std::vector<N const*> const& keys) const ->
+		   std::vector<typename node_map::const_iterator> {
+			auto order = std::vector<std::size_t>(keys.size());
+			for (auto i = std::size_t{0}; i < order.size(); ++i) {
+				order[i] = i;
+			}
+			std::sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) {
+				return *keys[a] < *keys[b];
 			});
+
+			auto ret = std::vector<typename node_map::const_iterator>(keys.size(), graph_.end());
+			auto it = graph_.begin();
+			for (auto const k : order) {
+				it = seek_node(it, *keys[k]);
+				if (it != graph_.end() && !(*keys[k] < *(it->first))) {
+					ret[k] = it;
+				}
+			}
+			return ret;
 		}
 
+	public:
+		class iterator {
+		public:
+			using value_type = graph<N, E>::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> reference {
+				return {*(node_->first), *(edge_->dst), *(edge_->weight)};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++edge_;
+				if (edge_ == node_->second.end()) {
+					++node_;
+					skip_empty();
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			/*
+			Step back to the previous edge, walking back over
+			nodes that have no outgoing edges.
+			*/
+			auto operator--() -> iterator& {
+				if (node_ == last_ || edge_ == node_->second.begin()) {
+					do {
+						--node_;
+					} while (node_->second.empty());
+					edge_ = std::prev(node_->second.end());
+				}
+				else {
+					--edge_;
+				}
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return node_ == other.node_ && edge_ == other.edge_;
+			}
+
+		private:
+			using node_iterator = typename node_map::const_iterator;
+			using edge_iterator = typename edge_set::const_iterator;
+
+			node_iterator node_;
+			node_iterator last_;
+			edge_iterator edge_;
+
+			// Points at the first edge of node, or the first edge after it
+			// if node has no outgoing edges.
+			explicit iterator(node_iterator node, node_iterator last)
+			: node_{node}, last_{last} {
+				skip_empty();
+			}
 
+			// Points at a specific edge of node
+			explicit iterator(node_iterator node, node_iterator last, edge_iterator edge)
+			: node_{node}, last_{last}, edge_{edge} {}
+
+			auto skip_empty() -> void {
+				while (node_ != last_ && node_->second.empty()) {
+					++node_;
+				}
+				edge_ = node_ != last_ ? node_->second.begin() : edge_iterator();
+			}
+
+			friend class graph<N, E>;
+		};
 	};
 }  //namespace gdgw
 
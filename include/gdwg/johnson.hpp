@@ -0,0 +1,144 @@
+#ifndef GDWG_JOHNSON_HPP
+#define GDWG_JOHNSON_HPP
+
+#include "gdwg/bellman_ford.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/distance_matrix.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		/*
+		Potentials h with w(u, v) + h(u) - h(v) >= 0 for every edge,
+		found by Bellman-Ford from a virtual source joined to every node
+		by a zero weight edge.
+		Throw runtime error if g has a negative cycle
+		*/
+		template<typename N, typename E>
+		auto johnson_potentials(csr<N, E> const& g) -> std::vector<E> {
+			auto paths = shortest_paths<E>{std::vector<E>(g.size(), E{}), std::vector<node_id>(g.size(), no_node)};
+			if (bellman_ford_rounds(edge_array(g), paths) != no_node) {
+				auto error_msg = "Cannot call gdwg::johnson on a graph with a negative cycle";
+				throw std::runtime_error(error_msg);
+			}
+			return std::move(paths.distance);
+		}
+	} // namespace detail
+
+	/*
+	All-pairs shortest paths for sparse graphs with negative weights.
+	Bellman-Ford first finds potentials that make every weight
+	non-negative, then one Dijkstra per source runs over the reweighted
+	edges. Sources are handed out one at a time to the worker threads,
+	so uneven searches still balance.
+
+	For every source, sink(src, distance) is called once with the
+	distances from src to every node id (detail::infinity<E>() if
+	unreached). The span is only valid during the call, and calls
+	for different sources come from several threads at once, so sink
+	must be safe to call concurrently. Only O(n) memory per thread
+	is used, never the full matrix.
+	Throw runtime error if g has a negative cycle
+	Time Complexity : O(n*e + n*(n+e)log(n))
+	*/
+	template<typename N, typename E, typename Sink>
+	   requires std::invocable<Sink&, node_id, std::span<E const>>
+	auto johnson(csr<N, E> const& g, Sink sink, std::size_t threads = 0) -> void {
+		auto const n = g.size();
+		auto const potential = detail::johnson_potentials(g);
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto reweighted = std::vector<E>(g.weights());
+		for (auto u = node_id{0}; u < n; ++u) {
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+				reweighted[k] += potential[u] - potential[targets[k]];
+			}
+		}
+
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+		auto next = std::atomic<std::size_t>{0};
+		detail::parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t) {
+			// Reset in time proportional to the nodes the last search reached
+			auto distance = std::vector<E>(n, detail::infinity<E>());
+			auto result = std::vector<E>(n, detail::infinity<E>());
+			auto reached = std::vector<node_id>{};
+			auto heap = detail::d_ary_heap<E>(n);
+			for (auto src = next.fetch_add(1, std::memory_order_relaxed); src < n;
+			     src = next.fetch_add(1, std::memory_order_relaxed)) {
+				distance[src] = E{};
+				heap.push_or_decrease(static_cast<node_id>(src), E{});
+				while (!heap.empty()) {
+					auto const [u, d] = heap.pop();
+					reached.push_back(u);
+					for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+						auto const v = targets[k];
+						auto const candidate = d + reweighted[k];
+						if (candidate < distance[v]) {
+							distance[v] = candidate;
+							heap.push_or_decrease(v, candidate);
+						}
+					}
+				}
+				for (auto const v : reached) {
+					result[v] = distance[v] - potential[src] + potential[v];
+				}
+				sink(static_cast<node_id>(src), std::span<E const>(result));
+				for (auto const v : reached) {
+					distance[v] = detail::infinity<E>();
+					result[v] = detail::infinity<E>();
+				}
+				reached.clear();
+			}
+		});
+	}
+
+	/*
+	All-pairs shortest paths by Johnson's algorithm, collected into
+	a matrix indexed by node id.
+	Throw runtime error if g has a negative cycle
+	*/
+	template<typename N, typename E>
+	auto johnson(csr<N, E> const& g, std::size_t threads = 0) -> distance_matrix<E> {
+		auto ret = distance_matrix<E>(g.size());
+		// Each source writes only its own row
+		johnson(
+		   g,
+		   [&ret](node_id src, std::span<E const> distance) {
+			   std::copy(distance.begin(), distance.end(), ret.row(src).begin());
+		   },
+		   threads);
+		return ret;
+	}
+
+	/*
+	Convenience overloads over a graph.
+	Node ids follow the order of g.nodes().
+	Throw runtime error if g has a negative cycle
+	*/
+	template<typename N, typename E, typename Sink>
+	   requires std::invocable<Sink&, node_id, std::span<E const>>
+	auto johnson(graph<N, E> const& g, Sink sink, std::size_t threads = 0) -> void {
+		johnson(csr(g), std::move(sink), threads);
+	}
+
+	template<typename N, typename E>
+	auto johnson(graph<N, E> const& g, std::size_t threads = 0) -> distance_matrix<E> {
+		return johnson(csr(g), threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_JOHNSON_HPP
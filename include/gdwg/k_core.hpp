@@ -0,0 +1,262 @@
+#ifndef GDWG_K_CORE_HPP
+#define GDWG_K_CORE_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace gdwg {
+	// Which edges count towards a node's degree
+	enum class degree_mode { in, out, total };
+
+	namespace detail {
+		/*
+		Degree of v under mode, and the nodes whose degree drops when v
+		is removed (one call per edge, so parallel edges repeat).
+		Self-loops count towards v's own degree but are never reported.
+		*/
+		template<typename N, typename E>
+		class peeling_adjacency {
+		public:
+			peeling_adjacency(csr<N, E> const& g, csr<N, E> const& reverse, degree_mode mode)
+			: g_{&g}
+			, reverse_{&reverse}
+			, mode_{mode} {}
+
+			[[nodiscard]] auto degree(node_id v) const -> std::size_t {
+				switch (mode_) {
+				case degree_mode::in: return reverse_->degree(v);
+				case degree_mode::out: return g_->degree(v);
+				default: return g_->degree(v) + reverse_->degree(v);
+				}
+			}
+
+			template<typename F>
+			auto for_each_affected(node_id v, F&& fn) const -> void {
+				// Removing v lowers the in-degree of its successors and the
+				// out-degree of its predecessors
+				if (mode_ != degree_mode::out) {
+					for (auto const w : g_->neighbours(v)) {
+						if (w != v) {
+							fn(w);
+						}
+					}
+				}
+				if (mode_ != degree_mode::in) {
+					for (auto const w : reverse_->neighbours(v)) {
+						if (w != v) {
+							fn(w);
+						}
+					}
+				}
+			}
+
+		private:
+			csr<N, E> const* g_;
+			csr<N, E> const* reverse_;
+			degree_mode mode_;
+		};
+	} // namespace detail
+
+	/*
+	Core number of every node, indexed by node id: the largest k such
+	that the node belongs to a subgraph in which every node has degree
+	at least k. reverse must be g.transpose(). Degrees count parallel
+	edges separately.
+	Batagelj-Zaversnik: nodes are kept sorted by current degree in an
+	array with the start of each degree's bin, and removing the node of
+	lowest degree moves each affected neighbour one bin down in O(1).
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	auto core_numbers(csr<N, E> const& g, csr<N, E> const& reverse, degree_mode mode = degree_mode::total)
+	   -> std::vector<std::size_t> {
+		auto const n = g.size();
+		auto const adjacency = detail::peeling_adjacency(g, reverse, mode);
+		auto degree = std::vector<std::size_t>(n);
+		auto max_degree = std::size_t{0};
+		for (auto v = node_id{0}; v < n; ++v) {
+			degree[v] = adjacency.degree(v);
+			max_degree = std::max(max_degree, degree[v]);
+		}
+
+		// Counting sort of the nodes by degree
+		auto bin = std::vector<std::size_t>(max_degree + 2, 0);
+		for (auto const d : degree) {
+			++bin[d + 1];
+		}
+		for (auto d = std::size_t{0}; d <= max_degree; ++d) {
+			bin[d + 1] += bin[d];
+		}
+		auto order = std::vector<node_id>(n);
+		auto position = std::vector<std::size_t>(n);
+		{
+			auto next = bin;
+			for (auto v = node_id{0}; v < n; ++v) {
+				position[v] = next[degree[v]]++;
+				order[position[v]] = v;
+			}
+		}
+
+		for (auto i = std::size_t{0}; i < n; ++i) {
+			auto const v = order[i];
+			adjacency.for_each_affected(v, [&](node_id u) {
+				if (degree[u] <= degree[v]) {
+					return;
+				}
+				// Swap u with the first node of its bin, then shrink the bin past it
+				auto const du = degree[u];
+				auto const first = bin[du];
+				auto const w = order[first];
+				if (u != w) {
+					std::swap(order[position[u]], order[first]);
+					std::swap(position[u], position[w]);
+				}
+				++bin[du];
+				--degree[u];
+			});
+		}
+		return degree;
+	}
+
+	/*
+	Core numbers by parallel peeling, giving the same result as
+	core_numbers(). For k from the smallest degree upwards, every node
+	of degree at most k is removed with core number k, in parallel
+	rounds: removing a round's nodes lowers their neighbours' degrees
+	atomically, and a neighbour whose degree falls to k joins the next
+	round. Suits graphs with few distinct core numbers.
+	Time Complexity : O(n*c + e) work, c being the number of
+	distinct core numbers
+	*/
+	template<typename N, typename E>
+	auto parallel_core_numbers(csr<N, E> const& g,
+	                           csr<N, E> const& reverse,
+	                           degree_mode mode = degree_mode::total,
+	                           std::size_t threads = 0) -> std::vector<std::size_t> {
+		auto const n = g.size();
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+		auto const adjacency = detail::peeling_adjacency(g, reverse, mode);
+		auto degree = std::vector<std::size_t>(n);
+		auto core = std::vector<std::size_t>(n, 0);
+		auto removed = std::vector<char>(n, 0);
+		auto found = std::vector<std::vector<node_id>>(threads);
+		auto lowest = std::vector<std::size_t>(threads);
+		detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+			for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+				degree[v] = adjacency.degree(v);
+			}
+		});
+
+		auto const gather = [&found](std::vector<node_id>& into) {
+			into.clear();
+			for (auto& part : found) {
+				into.insert(into.end(), part.begin(), part.end());
+				part.clear();
+			}
+		};
+
+		auto frontier = std::vector<node_id>{};
+		auto remaining = n;
+		auto k = std::size_t{0};
+		while (remaining > 0) {
+			// Nodes left at degree k or below, and the lowest degree left
+			std::fill(lowest.begin(), lowest.end(), static_cast<std::size_t>(-1));
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+				for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+					if (removed[v] == 0) {
+						lowest[t] = std::min(lowest[t], degree[v]);
+						if (degree[v] <= k) {
+							found[t].push_back(v);
+						}
+					}
+				}
+			});
+			gather(frontier);
+			if (frontier.empty()) {
+				k = *std::min_element(lowest.begin(), lowest.end());
+				continue;
+			}
+
+			while (!frontier.empty()) {
+				for (auto const v : frontier) {
+					removed[v] = 1;
+					core[v] = k;
+				}
+				remaining -= frontier.size();
+				detail::parallel_for(frontier.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+					for (auto i = begin; i < end; ++i) {
+						adjacency.for_each_affected(frontier[i], [&](node_id u) {
+							if (removed[u] != 0) {
+								return;
+							}
+							auto const old = std::atomic_ref<std::size_t>(degree[u]).fetch_sub(1, std::memory_order_relaxed);
+							// Exactly one decrement takes u down to k
+							if (old == k + 1) {
+								found[t].push_back(u);
+							}
+						});
+					}
+				});
+				gather(frontier);
+			}
+			++k;
+		}
+		return core;
+	}
+
+	/*
+	Convenience overloads over a graph.
+	Core numbers are indexed by node id, i.e. by position in g.nodes().
+	*/
+	template<typename N, typename E>
+	auto core_numbers(graph<N, E> const& g, degree_mode mode = degree_mode::total) -> std::vector<std::size_t> {
+		auto const snapshot = csr(g);
+		return core_numbers(snapshot, snapshot.transpose(), mode);
+	}
+
+	template<typename N, typename E>
+	auto parallel_core_numbers(graph<N, E> const& g, degree_mode mode = degree_mode::total, std::size_t threads = 0)
+	   -> std::vector<std::size_t> {
+		auto const snapshot = csr(g);
+		return parallel_core_numbers(snapshot, snapshot.transpose(), mode, threads);
+	}
+
+	/*
+	The k-core of g: the subgraph induced by the nodes with core
+	number at least k, with every edge between them.
+	*/
+	template<typename N, typename E>
+	auto k_core(graph<N, E> const& g, std::size_t k, degree_mode mode = degree_mode::total) -> graph<N, E> {
+		auto const snapshot = csr(g);
+		auto const core = core_numbers(snapshot, snapshot.transpose(), mode);
+		auto ret = graph<N, E>{};
+		for (auto v = node_id{0}; v < snapshot.size(); ++v) {
+			if (core[v] >= k) {
+				ret.insert_node(snapshot.node(v));
+			}
+		}
+		for (auto u = node_id{0}; u < snapshot.size(); ++u) {
+			if (core[u] < k) {
+				continue;
+			}
+			auto const targets = snapshot.neighbours(u);
+			auto const weights = snapshot.weights(u);
+			for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+				if (core[targets[i]] >= k) {
+					ret.insert_edge(snapshot.node(u), snapshot.node(targets[i]), weights[i]);
+				}
+			}
+		}
+		return ret;
+	}
+} // namespace gdwg
+
+#endif // GDWG_K_CORE_HPP
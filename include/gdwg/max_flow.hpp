@@ -0,0 +1,271 @@
+#ifndef GDWG_MAX_FLOW_HPP
+#define GDWG_MAX_FLOW_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Value of a maximum flow and a minimum cut achieving it:
+	source_side[v] is true for the nodes, indexed by node id, on the
+	source side of the cut. Every edge from the source side to the
+	sink side is saturated, so their capacities sum to flow.
+	*/
+	template<typename E>
+	struct max_flow_result {
+		E flow{};
+		std::vector<bool> source_side;
+	};
+
+	namespace detail {
+		/*
+		Residual network of a csr with weights as capacities. Parallel
+		edges are merged by adding their capacities, and every arc u->v
+		is paired with an arc v->u (of capacity 0 if g has no such edge)
+		at position reverse[a]. Arcs of each node are contiguous and
+		ordered by target, like the csr. Self-loops carry no flow and
+		are dropped.
+		*/
+		template<typename E>
+		struct residual_network {
+			std::vector<std::size_t> offsets;
+			std::vector<node_id> targets;
+			std::vector<E> capacity;
+			std::vector<std::size_t> reverse;
+
+			template<typename N>
+			explicit residual_network(csr<N, E> const& g)
+			: offsets(g.size() + 1, 0) {
+				auto arcs = std::vector<std::tuple<node_id, node_id, E>>{};
+				arcs.reserve(2 * g.num_edges());
+				for (auto u = node_id{0}; u < g.size(); ++u) {
+					auto const targets_of_u = g.neighbours(u);
+					auto const weights = g.weights(u);
+					for (auto k = std::size_t{0}; k < targets_of_u.size(); ++k) {
+						if (weights[k] < E{}) {
+							auto error_msg = "Cannot call gdwg::max_flow on a graph with negative capacities";
+							throw std::runtime_error(error_msg);
+						}
+						if (targets_of_u[k] != u) {
+							arcs.emplace_back(u, targets_of_u[k], weights[k]);
+							arcs.emplace_back(targets_of_u[k], u, E{});
+						}
+					}
+				}
+				std::sort(arcs.begin(), arcs.end(), [](auto const& a, auto const& b) {
+					return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+				});
+				auto last = std::pair(no_node, no_node);
+				for (auto const& [u, v, c] : arcs) {
+					if (last == std::pair(u, v)) {
+						capacity.back() += c;
+						continue;
+					}
+					last = std::pair(u, v);
+					targets.push_back(v);
+					capacity.push_back(c);
+					++offsets[u + 1];
+				}
+				for (auto u = std::size_t{0}; u < g.size(); ++u) {
+					offsets[u + 1] += offsets[u];
+				}
+				reverse.resize(targets.size());
+				for (auto u = node_id{0}; u < g.size(); ++u) {
+					for (auto a = offsets[u]; a < offsets[u + 1]; ++a) {
+						auto const v = targets[a];
+						auto const begin = targets.begin() + static_cast<std::ptrdiff_t>(offsets[v]);
+						auto const end = targets.begin() + static_cast<std::ptrdiff_t>(offsets[v + 1]);
+						reverse[a] = static_cast<std::size_t>(std::lower_bound(begin, end, u) - targets.begin());
+					}
+				}
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return offsets.size() - 1;
+			}
+		};
+	} // namespace detail
+
+	/*
+	Maximum flow from src to dst with edge weights as capacities, by
+	highest-label push-relabel on the residual network (parallel edges
+	merged). Active nodes are discharged highest label first. Labels
+	are recomputed exactly by a backward breadth-first search from dst
+	at the start and after every n relabels (global relabelling), and
+	once no node is left at some label every node above it is lifted
+	out of reach of dst at once (gap heuristic).
+	Only the first phase is run: it finds the flow value and the
+	minimum cut, without turning the preflow into a flow.
+	Throw runtime error if src == dst or an edge has a negative weight
+	Time Complexity : O(n^2 sqrt(e))
+	*/
+	template<typename N, typename E>
+	auto max_flow(csr<N, E> const& g, node_id src, node_id dst) -> max_flow_result<E> {
+		if (src == dst) {
+			auto error_msg = "Cannot call gdwg::max_flow with the same src and dst";
+			throw std::runtime_error(error_msg);
+		}
+		auto net = detail::residual_network<E>(g);
+		auto const n = net.size();
+		auto const& offsets = net.offsets;
+		auto const& targets = net.targets;
+		auto& capacity = net.capacity;
+
+		// Labels are distances to dst; n means dst cannot be reached
+		auto label = std::vector<std::size_t>(n, n);
+		auto excess = std::vector<E>(n, E{});
+		auto current = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+		// Active nodes and number of nodes at each label below n
+		auto active = std::vector<std::vector<node_id>>(n);
+		auto count = std::vector<std::size_t>(n, 0);
+		auto highest = std::size_t{0};
+
+		auto const activate = [&](node_id v) {
+			if (v != src && v != dst && label[v] < n) {
+				active[label[v]].push_back(v);
+				highest = std::max(highest, label[v]);
+			}
+		};
+		auto const global_relabel = [&] {
+			// Arcs skipped under the old labels may be admissible under the new ones
+			std::copy(offsets.begin(), offsets.end() - 1, current.begin());
+			std::fill(label.begin(), label.end(), n);
+			std::fill(count.begin(), count.end(), 0);
+			for (auto& bucket : active) {
+				bucket.clear();
+			}
+			highest = 0;
+			label[dst] = 0;
+			auto queue = std::vector<node_id>{dst};
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				auto const v = queue[i];
+				++count[label[v]];
+				for (auto a = offsets[v]; a < offsets[v + 1]; ++a) {
+					// u can push to v along the paired arc
+					auto const u = targets[a];
+					if (u != src && label[u] == n && E{} < capacity[net.reverse[a]]) {
+						label[u] = label[v] + 1;
+						queue.push_back(u);
+					}
+				}
+			}
+			for (auto v = node_id{0}; v < n; ++v) {
+				if (E{} < excess[v]) {
+					activate(v);
+				}
+			}
+		};
+		auto const push = [&](node_id u, std::size_t a) {
+			auto const v = targets[a];
+			auto const amount = std::min(excess[u], capacity[a]);
+			capacity[a] -= amount;
+			capacity[net.reverse[a]] += amount;
+			excess[u] -= amount;
+			auto const was_idle = !(E{} < excess[v]);
+			excess[v] += amount;
+			if (was_idle) {
+				activate(v);
+			}
+		};
+		auto const relabel = [&](node_id u) {
+			auto const old = label[u];
+			--count[old];
+			if (count[old] == 0) {
+				// Nothing above the gap can reach dst any more
+				for (auto v = node_id{0}; v < n; ++v) {
+					if (old < label[v] && label[v] < n) {
+						--count[label[v]];
+						label[v] = n;
+					}
+				}
+				label[u] = n;
+				return;
+			}
+			auto lowest = n;
+			for (auto a = offsets[u]; a < offsets[u + 1]; ++a) {
+				if (E{} < capacity[a]) {
+					lowest = std::min(lowest, label[targets[a]] + 1);
+				}
+			}
+			label[u] = lowest;
+			current[u] = offsets[u];
+			if (lowest < n) {
+				++count[lowest];
+			}
+		};
+
+		for (auto a = offsets[src]; a < offsets[src + 1]; ++a) {
+			excess[src] += capacity[a];
+			push(src, a);
+		}
+		global_relabel();
+		auto relabels = std::size_t{0};
+		while (true) {
+			while (highest > 0 && active[highest].empty()) {
+				--highest;
+			}
+			if (active[highest].empty()) {
+				break;
+			}
+			auto const u = active[highest].back();
+			active[highest].pop_back();
+			// Skip entries left behind by a gap or global relabel
+			if (label[u] != highest || !(E{} < excess[u])) {
+				continue;
+			}
+			while (E{} < excess[u] && label[u] < n) {
+				if (current[u] == offsets[u + 1]) {
+					relabel(u);
+					++relabels;
+					continue;
+				}
+				auto const a = current[u];
+				if (E{} < capacity[a] && label[u] == label[targets[a]] + 1) {
+					push(u, a);
+				}
+				else {
+					++current[u];
+				}
+			}
+			if (E{} < excess[u]) {
+				activate(u);
+			}
+			if (relabels >= n) {
+				relabels = 0;
+				global_relabel();
+			}
+		}
+
+		// Nodes that can still reach dst in the residual network form the sink side
+		global_relabel();
+		auto ret = max_flow_result<E>{excess[dst], std::vector<bool>(n)};
+		for (auto v = node_id{0}; v < n; ++v) {
+			ret.source_side[v] = label[v] == n;
+		}
+		return ret;
+	}
+
+	/*
+	Maximum flow from src to dst over g, with weights as capacities.
+	source_side is indexed by node id, i.e. by position in g.nodes().
+	Throw runtime error if either of is_node(src) or is_node(dst) are false
+	*/
+	template<typename N, typename E>
+	auto max_flow(graph<N, E> const& g, N const& src, N const& dst) -> max_flow_result<E> {
+		if (!g.is_node(src) || !g.is_node(dst)) {
+			auto error_msg = "Cannot call gdwg::max_flow if src or dst node don't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		return max_flow(snapshot, snapshot.id(src), snapshot.id(dst));
+	}
+} // namespace gdwg
+
+#endif // GDWG_MAX_FLOW_HPP
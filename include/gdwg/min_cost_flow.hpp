@@ -0,0 +1,264 @@
+#ifndef GDWG_MIN_COST_FLOW_HPP
+#define GDWG_MIN_COST_FLOW_HPP
+
+#include "gdwg/bellman_ford.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	template<typename Capacity, typename Cost>
+	struct flow_cost {
+		Capacity flow{};
+		Cost cost{};
+	};
+
+	/*
+	Min-cost flow by successive shortest paths with node potentials.
+	The residual network is built once from a csr, each edge becoming
+	an arc with the (capacity, cost) its weight projects to plus a
+	reverse arc; parallel edges stay separate since their costs can
+	differ. Every solve() starts from zero flow and reuses the same
+	buffers, so repeated solves (e.g. for different demands) do not
+	allocate.
+	Costs may be negative as long as no cycle of positive capacity
+	has a negative total cost.
+	*/
+	template<typename Capacity, typename Cost>
+	class min_cost_flow_solver {
+	public:
+		/*
+		projection(weight) returns the (capacity, cost) of an edge,
+		as a std::pair or std::tuple.
+		Throw runtime error if a capacity is negative
+		*/
+		template<typename N, typename E, typename Projection>
+		min_cost_flow_solver(csr<N, E> const& g, Projection projection)
+		: offsets_(g.size() + 1, 0)
+		, edge_arc_(g.num_edges())
+		, potential_(g.size())
+		, distance_(g.size())
+		, predecessor_(g.size())
+		, heap_(g.size()) {
+			auto const n = g.size();
+			for (auto u = node_id{0}; u < n; ++u) {
+				for (auto const v : g.neighbours(u)) {
+					++offsets_[u + 1];
+					++offsets_[v + 1];
+				}
+			}
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				offsets_[u + 1] += offsets_[u];
+			}
+			auto const arcs = offsets_.back();
+			head_.resize(arcs);
+			reverse_.resize(arcs);
+			capacity_.resize(arcs);
+			cost_.resize(arcs);
+			residual_.resize(arcs);
+			auto next = std::vector<std::size_t>(offsets_.begin(), offsets_.end() - 1);
+			auto k = std::size_t{0};
+			for (auto u = node_id{0}; u < n; ++u) {
+				auto const weights = g.weights(u);
+				auto const targets = g.neighbours(u);
+				for (auto i = std::size_t{0}; i < targets.size(); ++i, ++k) {
+					auto const [capacity, cost] = std::invoke(projection, weights[i]);
+					if (capacity < Capacity{}) {
+						auto error_msg = "Cannot call gdwg::min_cost_flow_solver with a negative capacity";
+						throw std::runtime_error(error_msg);
+					}
+					auto const v = targets[i];
+					auto const forward = next[u]++;
+					auto const backward = next[v]++;
+					head_[forward] = v;
+					head_[backward] = u;
+					reverse_[forward] = backward;
+					reverse_[backward] = forward;
+					capacity_[forward] = static_cast<Capacity>(capacity);
+					cost_[forward] = static_cast<Cost>(cost);
+					cost_[backward] = -static_cast<Cost>(cost);
+					negative_costs_ = negative_costs_ || cost_[forward] < Cost{};
+					edge_arc_[k] = forward;
+				}
+			}
+			residual_ = capacity_;
+			// Every solve starts from the same residual network, so the
+			// arcs Bellman-Ford needs are fixed
+			if (negative_costs_) {
+				for (auto u = node_id{0}; u < n; ++u) {
+					for (auto a = offsets_[u]; a < offsets_[u + 1]; ++a) {
+						if (Capacity{} < capacity_[a]) {
+							initial_arcs_.push_back({u, head_[a], cost_[a]});
+						}
+					}
+				}
+				initial_paths_.distance.resize(n);
+				initial_paths_.predecessor.resize(n);
+			}
+		}
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return potential_.size();
+		}
+
+		/*
+		Send as much flow as possible, but no more than limit, from src
+		to dst at minimum total cost, and return the flow and its cost.
+		Throw runtime error if src == dst, or a negative cost cycle is
+		reachable from src
+		Time Complexity : O(f*(n+e)log(n)) for f augmenting paths
+		*/
+		auto solve(node_id src, node_id dst, Capacity limit = std::numeric_limits<Capacity>::max())
+		   -> flow_cost<Capacity, Cost> {
+			if (src == dst) {
+				auto error_msg = "Cannot call gdwg::min_cost_flow_solver::solve with the same src and dst";
+				throw std::runtime_error(error_msg);
+			}
+			std::copy(capacity_.begin(), capacity_.end(), residual_.begin());
+			initial_potentials(src);
+
+			auto ret = flow_cost<Capacity, Cost>{};
+			while (ret.flow < limit && shortest_path(src, dst)) {
+				auto amount = limit - ret.flow;
+				for (auto v = dst; v != src; v = head_[reverse_[predecessor_[v]]]) {
+					amount = std::min(amount, residual_[predecessor_[v]]);
+				}
+				for (auto v = dst; v != src; v = head_[reverse_[predecessor_[v]]]) {
+					auto const a = predecessor_[v];
+					residual_[a] -= amount;
+					residual_[reverse_[a]] += amount;
+					ret.cost += static_cast<Cost>(amount) * cost_[a];
+				}
+				ret.flow += amount;
+			}
+			return ret;
+		}
+
+		/*
+		Flow the last solve() sent along edge k, k being the position
+		of the edge in the csr's targets() and weights()
+		*/
+		[[nodiscard]] auto flow(std::size_t k) const -> Capacity {
+			auto const a = edge_arc_[k];
+			return capacity_[a] - residual_[a];
+		}
+
+	private:
+		// Arcs of node u are [offsets_[u], offsets_[u + 1]), pointing at head_
+		std::vector<std::size_t> offsets_;
+		std::vector<node_id> head_;
+		std::vector<std::size_t> reverse_;
+		std::vector<Capacity> capacity_;
+		std::vector<Capacity> residual_;
+		std::vector<Cost> cost_;
+		// Forward arc of each csr edge
+		std::vector<std::size_t> edge_arc_;
+		bool negative_costs_ = false;
+		// Per solve buffers
+		std::vector<Cost> potential_;
+		std::vector<Cost> distance_;
+		// Arc the shortest path enters each node by
+		std::vector<std::size_t> predecessor_;
+		detail::d_ary_heap<Cost> heap_;
+		// Arcs with capacity, and their distances, for the initial potentials
+		std::vector<flat_edge<Cost>> initial_arcs_;
+		shortest_paths<Cost> initial_paths_;
+
+		/*
+		Potentials that make every reduced cost of a residual arc
+		non-negative: zero without negative costs, otherwise
+		Bellman-Ford distances from src.
+		*/
+		auto initial_potentials(node_id src) -> void {
+			std::fill(potential_.begin(), potential_.end(), Cost{});
+			if (!negative_costs_) {
+				return;
+			}
+			auto& paths = initial_paths_;
+			std::fill(paths.distance.begin(), paths.distance.end(), detail::infinity<Cost>());
+			std::fill(paths.predecessor.begin(), paths.predecessor.end(), no_node);
+			paths.distance[src] = Cost{};
+			if (detail::bellman_ford_rounds(initial_arcs_, paths) != no_node) {
+				auto error_msg = "Cannot call gdwg::min_cost_flow_solver::solve on a network with a negative cost cycle";
+				throw std::runtime_error(error_msg);
+			}
+			// Nodes src cannot reach never will, so their potential does not matter
+			for (auto v = std::size_t{0}; v < size(); ++v) {
+				if (paths.distance[v] != detail::infinity<Cost>()) {
+					potential_[v] = paths.distance[v];
+				}
+			}
+		}
+
+		/*
+		Dijkstra over reduced costs from src, then fold the distances
+		into the potentials. Return false if dst cannot be reached.
+		*/
+		auto shortest_path(node_id src, node_id dst) -> bool {
+			std::fill(distance_.begin(), distance_.end(), detail::infinity<Cost>());
+			heap_.clear();
+			distance_[src] = Cost{};
+			heap_.push_or_decrease(src, Cost{});
+			while (!heap_.empty()) {
+				auto const [u, d] = heap_.pop();
+				for (auto a = offsets_[u]; a < offsets_[u + 1]; ++a) {
+					if (!(Capacity{} < residual_[a])) {
+						continue;
+					}
+					auto const v = head_[a];
+					auto const candidate = d + cost_[a] + potential_[u] - potential_[v];
+					if (candidate < distance_[v]) {
+						distance_[v] = candidate;
+						predecessor_[v] = a;
+						heap_.push_or_decrease(v, candidate);
+					}
+				}
+			}
+			if (distance_[dst] == detail::infinity<Cost>()) {
+				return false;
+			}
+			for (auto v = std::size_t{0}; v < size(); ++v) {
+				if (distance_[v] != detail::infinity<Cost>()) {
+					potential_[v] += distance_[v];
+				}
+			}
+			return true;
+		}
+	};
+
+	template<typename N, typename E, typename Projection>
+	min_cost_flow_solver(csr<N, E> const&, Projection) -> min_cost_flow_solver<
+	   std::remove_cvref_t<std::tuple_element_t<0, std::invoke_result_t<Projection&, E const&>>>,
+	   std::remove_cvref_t<std::tuple_element_t<1, std::invoke_result_t<Projection&, E const&>>>>;
+
+	/*
+	Maximum flow from src to dst at minimum cost over g, with
+	projection(weight) giving each edge's (capacity, cost).
+	For repeated solves over the same graph keep a
+	min_cost_flow_solver instead.
+	Throw runtime error if either of is_node(src) or is_node(dst) are false
+	*/
+	template<typename N, typename E, typename Projection>
+	auto min_cost_flow(graph<N, E> const& g, N const& src, N const& dst, Projection projection) {
+		if (!g.is_node(src) || !g.is_node(dst)) {
+			auto error_msg = "Cannot call gdwg::min_cost_flow if src or dst node don't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		auto solver = min_cost_flow_solver(snapshot, std::move(projection));
+		return solver.solve(snapshot.id(src), snapshot.id(dst));
+	}
+} // namespace gdwg
+
+#endif // GDWG_MIN_COST_FLOW_HPP
@@ -0,0 +1,156 @@
+#ifndef GDWG_PAGERANK_HPP
+#define GDWG_PAGERANK_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg {
+	struct pagerank_options {
+		// Split a node's rank by edge weight instead of evenly over its edges
+		bool weighted = false;
+		std::size_t max_iterations = 100;
+		// 0 means one per hardware thread
+		std::size_t threads = 0;
+	};
+
+	/*
+	Ranks indexed by node id, summing to 1, and how the iteration
+	ended. residual is the L1 change of the last iteration.
+	*/
+	struct pagerank_result {
+		std::vector<double> rank;
+		std::size_t iterations = 0;
+		double residual = 0;
+		bool converged = false;
+	};
+
+	/*
+	PageRank by power iteration over a csr snapshot.
+	Each iteration pulls rank along the edges of g.transpose(), so
+	every thread writes only its own contiguous range of the new rank
+	vector and no atomics are needed. Rank of nodes without outgoing
+	edges is spread evenly over all nodes.
+	Stops once the L1 change of an iteration drops below tol, or
+	after options.max_iterations iterations.
+	Throw runtime error if options.weighted is set and an edge has a
+	negative weight, or E is not convertible to double
+	Time Complexity : O(n+e) per iteration
+	*/
+	template<typename N, typename E>
+	auto pagerank(csr<N, E> const& g, double damping = 0.85, double tol = 1e-6, pagerank_options const& options = {})
+	   -> pagerank_result {
+		auto const n = g.size();
+		auto ret = pagerank_result{std::vector<double>(n, 1.0 / static_cast<double>(n)), 0, 0, n == 0};
+		if (n == 0) {
+			return ret;
+		}
+
+		auto const reverse = g.transpose();
+		auto const& offsets = reverse.offsets();
+		auto const& sources = reverse.targets();
+		// Weight of each reverse edge as a double, only when weighted
+		auto share = std::vector<double>{};
+		// Total outgoing weight (or out-degree) of each node
+		auto out = std::vector<double>(n, 0);
+		if (options.weighted) {
+			if constexpr (std::is_convertible_v<E const&, double>) {
+				share.reserve(reverse.num_edges());
+				for (auto const& w : reverse.weights()) {
+					if (w < E{}) {
+						auto error_msg = "Cannot call gdwg::pagerank with weighted edges on negative edge weights";
+						throw std::runtime_error(error_msg);
+					}
+					share.push_back(static_cast<double>(w));
+				}
+				for (auto k = std::size_t{0}; k < sources.size(); ++k) {
+					out[sources[k]] += share[k];
+				}
+			}
+			else {
+				auto error_msg = "Cannot call gdwg::pagerank with weighted edges on weights not convertible to double";
+				throw std::runtime_error(error_msg);
+			}
+		}
+		else {
+			for (auto u = node_id{0}; u < n; ++u) {
+				out[u] = static_cast<double>(g.degree(u));
+			}
+		}
+
+		auto const threads = options.threads == 0 ? detail::default_threads() : options.threads;
+		auto contribution = std::vector<double>(n);
+		auto next = std::vector<double>(n);
+		// Per thread partial sums, combined after each pass
+		auto dangling_part = std::vector<double>(threads);
+		auto residual_part = std::vector<double>(threads);
+		auto const size = static_cast<double>(n);
+
+		auto& rank = ret.rank;
+		while (ret.iterations < options.max_iterations) {
+			std::fill(dangling_part.begin(), dangling_part.end(), 0.0);
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+				auto dangling = 0.0;
+				for (auto u = begin; u < end; ++u) {
+					if (out[u] > 0) {
+						contribution[u] = rank[u] / out[u];
+					}
+					else {
+						contribution[u] = 0;
+						dangling += rank[u];
+					}
+				}
+				dangling_part[t] = dangling;
+			});
+			auto const dangling = std::accumulate(dangling_part.begin(), dangling_part.end(), 0.0);
+			auto const base = (1 - damping) / size + damping * dangling / size;
+
+			std::fill(residual_part.begin(), residual_part.end(), 0.0);
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+				auto residual = 0.0;
+				for (auto v = begin; v < end; ++v) {
+					auto sum = 0.0;
+					if (share.empty()) {
+						for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+							sum += contribution[sources[k]];
+						}
+					}
+					else {
+						for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+							sum += contribution[sources[k]] * share[k];
+						}
+					}
+					next[v] = base + damping * sum;
+					residual += std::abs(next[v] - rank[v]);
+				}
+				residual_part[t] = residual;
+			});
+			rank.swap(next);
+			++ret.iterations;
+			ret.residual = std::accumulate(residual_part.begin(), residual_part.end(), 0.0);
+			if (ret.residual < tol) {
+				ret.converged = true;
+				break;
+			}
+		}
+		return ret;
+	}
+
+	/*
+	PageRank over g, with ranks in the order of g.nodes().
+	*/
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g, double damping = 0.85, double tol = 1e-6, pagerank_options const& options = {})
+	   -> pagerank_result {
+		return pagerank(csr(g), damping, tol, options);
+	}
+} // namespace gdwg
+
+#endif // GDWG_PAGERANK_HPP
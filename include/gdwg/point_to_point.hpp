@@ -0,0 +1,259 @@
+#ifndef GDWG_POINT_TO_POINT_HPP
+#define GDWG_POINT_TO_POINT_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/d_ary_heap.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+Point-to-point shortest path queries for when only one distance is
+needed. Each query runs in a path_workspace that is sized once and
+then reset in time proportional to the nodes the last query touched,
+so repeated queries do not allocate. Keep one workspace per thread;
+the csr snapshots can be shared between threads.
+*/
+namespace gdwg {
+	template<typename E>
+	class path_workspace {
+	public:
+		path_workspace() = default;
+
+		explicit path_workspace(std::size_t n) {
+			prepare(n);
+		}
+
+		/*
+		Return the nodes on the path found by the last query,
+		source first, or an empty path if the target was not reached.
+		*/
+		[[nodiscard]] auto path() const -> std::vector<node_id> {
+			auto ret = std::vector<node_id>{};
+			if (meeting_ == no_node) {
+				return ret;
+			}
+			for (auto v = meeting_;; v = forward_.predecessor[v]) {
+				ret.push_back(v);
+				if (forward_.predecessor[v] == v) {
+					break;
+				}
+			}
+			std::reverse(ret.begin(), ret.end());
+			if (bidirectional_) {
+				for (auto v = meeting_; backward_.predecessor[v] != v;) {
+					v = backward_.predecessor[v];
+					ret.push_back(v);
+				}
+			}
+			return ret;
+		}
+
+	private:
+		// One search direction
+		struct half {
+			std::vector<E> distance;
+			std::vector<node_id> predecessor;
+			std::vector<node_id> touched;
+			detail::d_ary_heap<E> heap;
+
+			auto prepare(std::size_t n) -> void {
+				if (distance.size() != n) {
+					distance.assign(n, detail::infinity<E>());
+					predecessor.assign(n, no_node);
+					heap.resize(n);
+					touched.clear();
+				}
+				else {
+					reset();
+				}
+			}
+
+			// Undo only what the last search wrote
+			auto reset() -> void {
+				for (auto const v : touched) {
+					distance[v] = detail::infinity<E>();
+					predecessor[v] = no_node;
+				}
+				touched.clear();
+				heap.clear();
+			}
+
+			auto relax(node_id v, E const& d, node_id from, E const& key) -> bool {
+				if (!(d < distance[v])) {
+					return false;
+				}
+				if (predecessor[v] == no_node) {
+					touched.push_back(v);
+				}
+				distance[v] = d;
+				predecessor[v] = from;
+				heap.push_or_decrease(v, key);
+				return true;
+			}
+		};
+
+		half forward_;
+		half backward_;
+		node_id meeting_ = no_node;
+		bool bidirectional_ = false;
+
+		auto prepare(std::size_t n) -> void {
+			forward_.prepare(n);
+			meeting_ = no_node;
+			bidirectional_ = false;
+		}
+
+		auto prepare_both(std::size_t n) -> void {
+			prepare(n);
+			backward_.prepare(n);
+			bidirectional_ = true;
+		}
+
+		template<typename N, typename F>
+		friend auto
+		bidirectional_dijkstra(csr<N, F> const&, csr<N, F> const&, node_id, node_id, path_workspace<F>&) -> F;
+
+		template<typename N, typename F, typename Heuristic>
+		friend auto astar(csr<N, F> const&, node_id, node_id, Heuristic, path_workspace<F>&) -> F;
+	};
+
+	/*
+	Distance from src to dst, searching forward from src over g and
+	backward from dst over reverse (g.transpose()) at the same time,
+	always expanding the side with the smaller frontier key. The search
+	stops once the two frontier keys together reach the best meeting
+	distance, which typically settles far fewer nodes than one Dijkstra.
+	Return detail::infinity<E>() if dst cannot be reached.
+	Throw runtime error if an edge with a negative weight is relaxed
+	*/
+	template<typename N, typename E>
+	auto bidirectional_dijkstra(csr<N, E> const& g,
+	                            csr<N, E> const& reverse,
+	                            node_id src,
+	                            node_id dst,
+	                            path_workspace<E>& ws) -> E {
+		ws.prepare_both(g.size());
+		auto& fwd = ws.forward_;
+		auto& bwd = ws.backward_;
+		fwd.relax(src, E{}, src, E{});
+		bwd.relax(dst, E{}, dst, E{});
+		auto best = detail::infinity<E>();
+		if (src == dst) {
+			ws.meeting_ = src;
+			return E{};
+		}
+
+		auto const expand = [&best, &ws](auto& side, auto const& other, csr<N, E> const& adjacency) {
+			auto const [u, d] = side.heap.pop();
+			auto const& targets = adjacency.targets();
+			auto const& weights = adjacency.weights();
+			for (auto k = adjacency.offsets()[u]; k < adjacency.offsets()[u + 1]; ++k) {
+				if (weights[k] < E{}) {
+					auto error_msg = "Cannot call gdwg::bidirectional_dijkstra on a graph with negative edge weights";
+					throw std::runtime_error(error_msg);
+				}
+				auto const v = targets[k];
+				auto const candidate = d + weights[k];
+				side.relax(v, candidate, u, candidate);
+				if (other.predecessor[v] != no_node && side.distance[v] + other.distance[v] < best) {
+					best = side.distance[v] + other.distance[v];
+					ws.meeting_ = v;
+				}
+			}
+		};
+
+		while (!fwd.heap.empty() && !bwd.heap.empty()) {
+			auto const& f_top = fwd.heap.top().second;
+			auto const& b_top = bwd.heap.top().second;
+			if (!(f_top + b_top < best)) {
+				break;
+			}
+			if (!(b_top < f_top)) {
+				expand(fwd, bwd, g);
+			}
+			else {
+				expand(bwd, fwd, reverse);
+			}
+		}
+		return best;
+	}
+
+	/*
+	Distance from src to dst using A* with heuristic(v) estimating the
+	distance from node id v to dst. The heuristic must never overestimate;
+	if it is also consistent every node is settled at most once.
+	Return detail::infinity<E>() if dst cannot be reached.
+	Throw runtime error if an edge with a negative weight is relaxed
+	*/
+	template<typename N, typename E, typename Heuristic>
+	auto astar(csr<N, E> const& g, node_id src, node_id dst, Heuristic heuristic, path_workspace<E>& ws) -> E {
+		ws.prepare(g.size());
+		auto& fwd = ws.forward_;
+		fwd.relax(src, E{}, src, heuristic(src));
+
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto const& weights = g.weights();
+		while (!fwd.heap.empty()) {
+			auto const u = fwd.heap.pop().first;
+			if (u == dst) {
+				ws.meeting_ = dst;
+				return fwd.distance[dst];
+			}
+			auto const d = fwd.distance[u];
+			for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+				if (weights[k] < E{}) {
+					auto error_msg = "Cannot call gdwg::astar on a graph with negative edge weights";
+					throw std::runtime_error(error_msg);
+				}
+				auto const v = targets[k];
+				auto const candidate = d + weights[k];
+				if (candidate < fwd.distance[v]) {
+					fwd.relax(v, candidate, u, candidate + heuristic(v));
+				}
+			}
+		}
+		return detail::infinity<E>();
+	}
+
+	/*
+	Convenience overloads that build the snapshots for a single query.
+	For repeated queries build the csr (and its transpose) once and
+	reuse a workspace instead.
+	Throw runtime error if either of is_node(src) or is_node(dst) are false
+	*/
+	template<typename N, typename E>
+	auto bidirectional_dijkstra(graph<N, E> const& g, N const& src, N const& dst) -> E {
+		if (!g.is_node(src) || !g.is_node(dst)) {
+			auto error_msg = "Cannot call gdwg::bidirectional_dijkstra if src or dst node don't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		auto ws = path_workspace<E>(snapshot.size());
+		return bidirectional_dijkstra(snapshot, snapshot.transpose(), snapshot.id(src), snapshot.id(dst), ws);
+	}
+
+	template<typename N, typename E, typename Heuristic>
+	auto astar(graph<N, E> const& g, N const& src, N const& dst, Heuristic heuristic) -> E {
+		if (!g.is_node(src) || !g.is_node(dst)) {
+			auto error_msg = "Cannot call gdwg::astar if src or dst node don't exist in the graph";
+			throw std::runtime_error(error_msg);
+		}
+		auto const snapshot = csr(g);
+		auto ws = path_workspace<E>(snapshot.size());
+		return astar(
+		   snapshot,
+		   snapshot.id(src),
+		   snapshot.id(dst),
+		   [&snapshot, &heuristic](node_id v) { return heuristic(snapshot.node(v)); },
+		   ws);
+	}
+} // namespace gdwg
+
+#endif // GDWG_POINT_TO_POINT_HPP
@@ -0,0 +1,211 @@
+#ifndef GDWG_REACHABILITY_HPP
+#define GDWG_REACHABILITY_HPP
+
+#include "gdwg/components.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/scc.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Index answering "can src reach dst?" between node ids, i.e.
+	positions in graph::nodes(), without searching the graph.
+
+	Nodes of one strongly connected component reach exactly the same
+	nodes, so the index is built over the DAG of components. Every
+	component gets an out label, the hubs it reaches, and an in label,
+	the hubs that reach it, such that a reaches b exactly when the two
+	labels share a hub (pruned landmark labelling). Hubs are taken in
+	order of decreasing degree product, and a search from a hub stops
+	wherever the labels so far already answer the query, which keeps
+	labels to a handful of hubs on most graphs.
+	*/
+	class reachability_index {
+	public:
+		reachability_index() = default;
+
+		/*
+		Build the index over g.
+		Time Complexity : O(h*(n+e)*l), h being the number of hubs that
+		label anything and l the largest label; far less in practice
+		*/
+		template<typename N, typename E>
+		explicit reachability_index(csr<N, E> const& g) {
+			auto const scc = tarjan_scc(g);
+			component_ = scc.component;
+			auto const count = scc.count;
+
+			// The DAG of components without repeated edges
+			auto forward = std::vector<std::vector<node_id>>(count);
+			auto backward = std::vector<std::vector<node_id>>(count);
+			for (auto u = node_id{0}; u < g.size(); ++u) {
+				for (auto const v : g.neighbours(u)) {
+					if (component_[u] != component_[v]) {
+						forward[component_[u]].push_back(component_[v]);
+					}
+				}
+			}
+			for (auto c = node_id{0}; c < count; ++c) {
+				std::sort(forward[c].begin(), forward[c].end());
+				forward[c].erase(std::unique(forward[c].begin(), forward[c].end()), forward[c].end());
+				for (auto const d : forward[c]) {
+					backward[d].push_back(c);
+				}
+			}
+
+			// Well connected components first, as they answer the most
+			// queries. Ties are broken at random: in topological order a
+			// long path would label every node with every later one.
+			auto order = std::vector<node_id>(count);
+			std::iota(order.begin(), order.end(), node_id{0});
+			std::shuffle(order.begin(), order.end(), std::mt19937_64(count));
+			auto const weight = [&](node_id c) {
+				return (forward[c].size() + 1) * (backward[c].size() + 1);
+			};
+			std::stable_sort(order.begin(), order.end(), [&](node_id a, node_id b) { return weight(a) > weight(b); });
+
+			// Labels hold hub ranks, so appending in rank order keeps them sorted
+			auto out_labels = std::vector<std::vector<node_id>>(count);
+			auto in_labels = std::vector<std::vector<node_id>>(count);
+			auto visited = std::vector<bool>(count, false);
+			auto queue = std::vector<node_id>{};
+			auto const pruned_search = [&](node_id hub,
+			                               node_id rank,
+			                               std::vector<std::vector<node_id>> const& adjacency,
+			                               std::vector<std::vector<node_id>>& labels,
+			                               auto answered) {
+				queue.assign(1, hub);
+				visited[hub] = true;
+				for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+					auto const c = queue[i];
+					if (answered(c)) {
+						continue;
+					}
+					labels[c].push_back(rank);
+					for (auto const d : adjacency[c]) {
+						if (!visited[d]) {
+							visited[d] = true;
+							queue.push_back(d);
+						}
+					}
+				}
+				for (auto const c : queue) {
+					visited[c] = false;
+				}
+			};
+			for (auto rank = node_id{0}; rank < count; ++rank) {
+				auto const hub = order[rank];
+				pruned_search(hub, rank, forward, in_labels, [&](node_id c) {
+					return shares_hub(out_labels[hub], in_labels[c]);
+				});
+				pruned_search(hub, rank, backward, out_labels, [&](node_id c) {
+					return shares_hub(out_labels[c], in_labels[hub]);
+				});
+			}
+			out_ = flatten(out_labels);
+			in_ = flatten(in_labels);
+		}
+
+		/*
+		Build the index over g. Node ids are positions in g.nodes().
+		*/
+		template<typename N, typename E>
+		explicit reachability_index(graph<N, E> const& g)
+		: reachability_index(csr(g)) {}
+
+		// Number of nodes
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return component_.size();
+		}
+
+		// Number of strongly connected components
+		[[nodiscard]] auto num_components() const noexcept -> std::size_t {
+			return out_.offsets.empty() ? 0 : out_.offsets.size() - 1;
+		}
+
+		// Total number of hubs over all in and out labels
+		[[nodiscard]] auto num_labels() const noexcept -> std::size_t {
+			return out_.hubs.size() + in_.hubs.size();
+		}
+
+		// Memory held by the index
+		[[nodiscard]] auto bytes() const noexcept -> std::size_t {
+			return sizeof(node_id) * (component_.size() + out_.hubs.size() + in_.hubs.size())
+			       + sizeof(std::size_t) * (out_.offsets.size() + in_.offsets.size());
+		}
+
+		/*
+		Return true if there is a path from src to dst; every node
+		reaches itself. Components are numbered in topological order,
+		so most negative answers need no label at all.
+		Time Complexity : O(l), l being the label size
+		*/
+		[[nodiscard]] auto is_reachable(node_id src, node_id dst) const -> bool {
+			auto const a = component_[src];
+			auto const b = component_[dst];
+			if (a == b) {
+				return true;
+			}
+			if (b < a) {
+				return false;
+			}
+			return shares_hub(out_.label(a), in_.label(b));
+		}
+
+	private:
+		// Labels of all components in one array
+		struct flat_labels {
+			std::vector<std::size_t> offsets;
+			std::vector<node_id> hubs;
+
+			[[nodiscard]] auto label(node_id c) const -> std::span<node_id const> {
+				return {hubs.data() + offsets[c], offsets[c + 1] - offsets[c]};
+			}
+		};
+
+		std::vector<node_id> component_;
+		flat_labels out_;
+		flat_labels in_;
+
+		static auto flatten(std::vector<std::vector<node_id>> const& labels) -> flat_labels {
+			auto ret = flat_labels{std::vector<std::size_t>(labels.size() + 1, 0), {}};
+			for (auto c = std::size_t{0}; c < labels.size(); ++c) {
+				ret.offsets[c + 1] = ret.offsets[c] + labels[c].size();
+			}
+			ret.hubs.reserve(ret.offsets.back());
+			for (auto const& label : labels) {
+				ret.hubs.insert(ret.hubs.end(), label.begin(), label.end());
+			}
+			return ret;
+		}
+
+		// Whether two labels sorted by hub rank have a hub in common
+		template<typename A, typename B>
+		static auto shares_hub(A const& a, B const& b) -> bool {
+			auto i = a.begin();
+			auto j = b.begin();
+			while (i != a.end() && j != b.end()) {
+				if (*i == *j) {
+					return true;
+				}
+				if (*i < *j) {
+					++i;
+				}
+				else {
+					++j;
+				}
+			}
+			return false;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_REACHABILITY_HPP
@@ -0,0 +1,262 @@
+#ifndef GDWG_SCC_HPP
+#define GDWG_SCC_HPP
+
+#include "gdwg/components.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Strongly connected components by Tarjan's algorithm, with an
+	explicit stack instead of recursion so long paths cannot overflow
+	the call stack.
+	Components are numbered in topological order: every edge goes from
+	a component to itself or to one with a higher id.
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	auto tarjan_scc(csr<N, E> const& g) -> components {
+		auto const n = g.size();
+		auto const& offsets = g.offsets();
+		auto const& targets = g.targets();
+		auto ret = components{std::vector<node_id>(n, no_node), 0};
+		auto index = std::vector<node_id>(n, no_node);
+		auto low = std::vector<node_id>(n);
+		auto on_stack = std::vector<bool>(n, false);
+		auto stack = std::vector<node_id>{};
+		// Node being visited and the next of its edges to follow
+		auto call = std::vector<std::pair<node_id, std::size_t>>{};
+		auto counter = node_id{0};
+
+		auto const visit = [&](node_id v) {
+			index[v] = low[v] = counter++;
+			stack.push_back(v);
+			on_stack[v] = true;
+			call.emplace_back(v, offsets[v]);
+		};
+
+		for (auto s = node_id{0}; s < n; ++s) {
+			if (index[s] != no_node) {
+				continue;
+			}
+			visit(s);
+			while (!call.empty()) {
+				auto const u = call.back().first;
+				if (call.back().second < offsets[u + 1]) {
+					auto const v = targets[call.back().second++];
+					if (index[v] == no_node) {
+						visit(v);
+					}
+					else if (on_stack[v]) {
+						low[u] = std::min(low[u], index[v]);
+					}
+					continue;
+				}
+				call.pop_back();
+				if (!call.empty()) {
+					auto const parent = call.back().first;
+					low[parent] = std::min(low[parent], low[u]);
+				}
+				if (low[u] == index[u]) {
+					auto v = no_node;
+					do {
+						v = stack.back();
+						stack.pop_back();
+						on_stack[v] = false;
+						ret.component[v] = static_cast<node_id>(ret.count);
+					} while (v != u);
+					++ret.count;
+				}
+			}
+		}
+		// Tarjan finishes sink components first
+		for (auto& c : ret.component) {
+			c = static_cast<node_id>(ret.count - 1 - c);
+		}
+		return ret;
+	}
+
+	/*
+	Strongly connected components by forward-backward colouring, for
+	large graphs of small diameter. reverse must be g.transpose().
+	Each round first trims nodes with no remaining in or out edges,
+	which are components of their own. Every remaining node then takes
+	the largest id that can reach it (propagated forward until stable),
+	and the component of each colour root is the nodes of its colour
+	that can reach it (propagated backward). All passes pull from
+	neighbours, so each thread writes only its own range of nodes.
+	Component ids are dense but in no particular order.
+	Time Complexity : O(d*(n+e)) per round, d being the longest path
+	a colour or mark has to travel
+	*/
+	template<typename N, typename E>
+	auto parallel_scc(csr<N, E> const& g, csr<N, E> const& reverse, std::size_t threads = 0) -> components {
+		auto const n = g.size();
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+		// Component root of each node, no_node while unassigned
+		auto root = std::vector<node_id>(n, no_node);
+		auto colour = std::vector<node_id>(n);
+		auto marked = std::vector<char>(n);
+		auto changed = std::vector<char>(threads);
+
+		auto const load = [](node_id const& x) {
+			return std::atomic_ref<node_id const>(x).load(std::memory_order_relaxed);
+		};
+		auto const store = [](node_id& x, node_id value) {
+			std::atomic_ref<node_id>(x).store(value, std::memory_order_relaxed);
+		};
+		auto const assigned = [&](node_id v) { return load(root[v]) != no_node; };
+		// Repeat pass over every unassigned node until no pass changes anything
+		auto const until_stable = [&](auto pass) {
+			auto again = true;
+			while (again) {
+				std::fill(changed.begin(), changed.end(), 0);
+				detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t t) {
+					for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+						if (!assigned(v) && pass(v)) {
+							changed[t] = 1;
+						}
+					}
+				});
+				again = std::find(changed.begin(), changed.end(), 1) != changed.end();
+			}
+		};
+		auto const has_live = [&](csr<N, E> const& adjacency, node_id v) {
+			auto const neighbours = adjacency.neighbours(v);
+			return std::any_of(neighbours.begin(), neighbours.end(), [&](node_id w) {
+				return w != v && !assigned(w);
+			});
+		};
+
+		auto remaining = n;
+		while (remaining > 0) {
+			// Nodes without live in or out edges cannot be on a cycle
+			until_stable([&](node_id v) {
+				if (has_live(g, v) && has_live(reverse, v)) {
+					return false;
+				}
+				store(root[v], v);
+				return true;
+			});
+
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+					store(colour[v], v);
+					marked[v] = 0;
+				}
+			});
+			until_stable([&](node_id v) {
+				auto best = load(colour[v]);
+				for (auto const u : reverse.neighbours(v)) {
+					if (!assigned(u)) {
+						best = std::max(best, load(colour[u]));
+					}
+				}
+				if (best == load(colour[v])) {
+					return false;
+				}
+				store(colour[v], best);
+				return true;
+			});
+
+			// Roots are marked, then everything of their colour that reaches a mark
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+					if (!assigned(v) && colour[v] == v) {
+						std::atomic_ref<char>(marked[v]).store(1, std::memory_order_relaxed);
+					}
+				}
+			});
+			until_stable([&](node_id v) {
+				if (std::atomic_ref<char>(marked[v]).load(std::memory_order_relaxed) != 0) {
+					return false;
+				}
+				auto const c = colour[v];
+				for (auto const w : g.neighbours(v)) {
+					if (!assigned(w) && colour[w] == c
+					    && std::atomic_ref<char>(marked[w]).load(std::memory_order_relaxed) != 0) {
+						std::atomic_ref<char>(marked[v]).store(1, std::memory_order_relaxed);
+						return true;
+					}
+				}
+				return false;
+			});
+
+			detail::parallel_for(n, threads, [&](std::size_t begin, std::size_t end, std::size_t) {
+				for (auto v = static_cast<node_id>(begin); v < end; ++v) {
+					if (!assigned(v) && marked[v] != 0) {
+						store(root[v], colour[v]);
+					}
+				}
+			});
+			remaining = static_cast<std::size_t>(std::count(root.begin(), root.end(), no_node));
+		}
+
+		return detail::dense_components(root);
+	}
+
+	/*
+	Convenience overloads over a graph.
+	Components are indexed by node id, i.e. by position in g.nodes().
+	*/
+	template<typename N, typename E>
+	auto tarjan_scc(graph<N, E> const& g) -> components {
+		return tarjan_scc(csr(g));
+	}
+
+	template<typename N, typename E>
+	auto parallel_scc(graph<N, E> const& g, std::size_t threads = 0) -> components {
+		auto const snapshot = csr(g);
+		return parallel_scc(snapshot, snapshot.transpose(), threads);
+	}
+
+	/*
+	The DAG of strongly connected components of g as a new graph.
+	Node i is component i of tarjan_scc(g), so nodes are already in
+	topological order. Edges between different components become a
+	single edge carrying the smallest weight among them; edges inside
+	a component are dropped.
+	Time Complexity : O((n+e)log(n))
+	*/
+	template<typename N, typename E>
+	auto condensation(graph<N, E> const& g) -> graph<node_id, E> {
+		auto const snapshot = csr(g);
+		auto const scc = tarjan_scc(snapshot);
+		auto ret = graph<node_id, E>{};
+		for (auto c = node_id{0}; c < scc.count; ++c) {
+			ret.insert_node(c);
+		}
+		auto cheapest = std::map<std::pair<node_id, node_id>, E>{};
+		for (auto u = node_id{0}; u < snapshot.size(); ++u) {
+			auto const targets = snapshot.neighbours(u);
+			auto const weights = snapshot.weights(u);
+			for (auto k = std::size_t{0}; k < targets.size(); ++k) {
+				auto const from = scc.component[u];
+				auto const to = scc.component[targets[k]];
+				if (from == to) {
+					continue;
+				}
+				auto const [it, inserted] = cheapest.try_emplace({from, to}, weights[k]);
+				if (!inserted && weights[k] < it->second) {
+					it->second = weights[k];
+				}
+			}
+		}
+		for (auto const& [key, weight] : cheapest) {
+			ret.insert_edge(key.first, key.second, weight);
+		}
+		return ret;
+	}
+} // namespace gdwg
+
+#endif // GDWG_SCC_HPP
@@ -0,0 +1,61 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include "gdwg/csr.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		/*
+		Distance of a node that has not been reached.
+		Infinity for floating point weights, the largest value otherwise.
+		*/
+		template<typename E>
+		constexpr auto infinity() -> E {
+			if constexpr (std::numeric_limits<E>::has_infinity) {
+				return std::numeric_limits<E>::infinity();
+			}
+			else {
+				return std::numeric_limits<E>::max();
+			}
+		}
+	} // namespace detail
+
+	/*
+	Result of a single-source shortest path search, indexed by node id.
+	The source is its own predecessor, and unreached nodes have
+	no_node as predecessor and detail::infinity<E>() as distance.
+	*/
+	template<typename E>
+	struct shortest_paths {
+		std::vector<E> distance;
+		std::vector<node_id> predecessor;
+
+		[[nodiscard]] auto reached(node_id v) const -> bool {
+			return predecessor[v] != no_node;
+		}
+
+		/*
+		Return the nodes on the shortest path from the source to v,
+		source first, or an empty path if v was not reached.
+		*/
+		[[nodiscard]] auto path(node_id v) const -> std::vector<node_id> {
+			auto ret = std::vector<node_id>{};
+			if (!reached(v)) {
+				return ret;
+			}
+			ret.push_back(v);
+			while (predecessor[v] != v) {
+				v = predecessor[v];
+				ret.push_back(v);
+			}
+			std::reverse(ret.begin(), ret.end());
+			return ret;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_HPP
@@ -0,0 +1,87 @@
+#ifndef GDWG_TOPOLOGICAL_ORDER_HPP
+#define GDWG_TOPOLOGICAL_ORDER_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		/*
+		Kahn's algorithm. Nodes on or behind a cycle are never placed,
+		so the order is complete only if g is acyclic.
+		*/
+		template<typename N, typename E>
+		auto kahn_order(csr<N, E> const& g) -> std::vector<node_id> {
+			auto const n = g.size();
+			auto in_degree = std::vector<std::size_t>(n, 0);
+			for (auto const v : g.targets()) {
+				++in_degree[v];
+			}
+			auto ret = std::vector<node_id>{};
+			ret.reserve(n);
+			for (auto v = node_id{0}; v < n; ++v) {
+				if (in_degree[v] == 0) {
+					ret.push_back(v);
+				}
+			}
+			// ret doubles as the queue of nodes whose predecessors are all placed
+			for (auto i = std::size_t{0}; i < ret.size(); ++i) {
+				for (auto const v : g.neighbours(ret[i])) {
+					if (--in_degree[v] == 0) {
+						ret.push_back(v);
+					}
+				}
+			}
+			return ret;
+		}
+	} // namespace detail
+
+	/*
+	Node ids ordered so that every edge goes from an earlier node to a
+	later one. Nodes without incoming edges come first in id order,
+	then the rest in the order their last predecessor is placed.
+	Throw runtime error if g has a cycle (including a self-loop)
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	auto topological_order(csr<N, E> const& g) -> std::vector<node_id> {
+		auto ret = detail::kahn_order(g);
+		if (ret.size() != g.size()) {
+			auto error_msg = "Cannot call gdwg::topological_order on a graph with a cycle";
+			throw std::runtime_error(error_msg);
+		}
+		return ret;
+	}
+
+	/*
+	Nodes of g ordered so that every edge goes from an earlier node to
+	a later one.
+	Throw runtime error if g has a cycle (including a self-loop)
+	*/
+	template<typename N, typename E>
+	auto topological_order(graph<N, E> const& g) -> std::vector<N> {
+		auto const snapshot = csr(g);
+		auto ret = std::vector<N>{};
+		ret.reserve(snapshot.size());
+		for (auto const v : topological_order(snapshot)) {
+			ret.push_back(snapshot.node(v));
+		}
+		return ret;
+	}
+
+	/*
+	Return true if g has a cycle (including a self-loop)
+	Time Complexity : O(n+e)
+	*/
+	template<typename N, typename E>
+	auto has_cycle(graph<N, E> const& g) -> bool {
+		auto const snapshot = csr(g);
+		return detail::kahn_order(snapshot).size() != snapshot.size();
+	}
+} // namespace gdwg
+
+#endif // GDWG_TOPOLOGICAL_ORDER_HPP
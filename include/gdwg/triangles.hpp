@@ -0,0 +1,143 @@
+#ifndef GDWG_TRIANGLES_HPP
+#define GDWG_TRIANGLES_HPP
+
+#include "gdwg/csr.hpp"
+#include "gdwg/detail/parallel.hpp"
+#include "gdwg/detail/undirected.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gdwg {
+	/*
+	Triangles of the underlying simple undirected graph (edge direction,
+	weights, parallel edges and self-loops ignored), indexed by node id.
+	count[v] is the number of triangles through v and clustering[v] the
+	fraction of pairs of v's neighbours that are themselves neighbours.
+	*/
+	struct triangles {
+		std::vector<std::uint64_t> count;
+		std::uint64_t total = 0;
+		std::vector<double> clustering;
+	};
+
+	namespace detail {
+		// Nodes handed to a thread at a time, small enough to balance skewed degrees
+		inline constexpr std::size_t triangle_grain = 64;
+
+		/*
+		Call found(w) for every id in both sorted lists.
+		The cursor updates are branch free, so the loop does not stall
+		on mispredicted comparisons.
+		*/
+		template<typename F>
+		auto intersect(std::span<node_id const> a, std::span<node_id const> b, F&& found) -> std::size_t {
+			auto i = std::size_t{0};
+			auto j = std::size_t{0};
+			auto common = std::size_t{0};
+			while (i < a.size() && j < b.size()) {
+				auto const x = a[i];
+				auto const y = b[j];
+				if (x == y) {
+					found(x);
+					++common;
+				}
+				i += x <= y ? 1 : 0;
+				j += y <= x ? 1 : 0;
+			}
+			return common;
+		}
+	} // namespace detail
+
+	/*
+	Count triangles in parallel. reverse must be g.transpose().
+	Every edge is oriented from the endpoint of lower degree to the
+	higher (ties by id), so each triangle is found exactly once, from
+	its lowest node, and no node has to scan more than O(sqrt(e))
+	oriented neighbours. Threads take small batches of nodes from a
+	shared counter and intersect sorted neighbour lists.
+	Time Complexity : O(e*sqrt(e)) in total
+	*/
+	template<typename N, typename E>
+	auto triangle_count(csr<N, E> const& g, csr<N, E> const& reverse, std::size_t threads = 0) -> triangles {
+		auto const adjacency = detail::undirected_adjacency(g, reverse);
+		auto const n = adjacency.size();
+		auto const before = [&adjacency](node_id u, node_id v) {
+			auto const du = adjacency.degree(u);
+			auto const dv = adjacency.degree(v);
+			return du < dv || (du == dv && u < v);
+		};
+
+		// Neighbours later in the orientation, still sorted by id
+		auto offsets = std::vector<std::size_t>(n + 1, 0);
+		auto later = std::vector<node_id>{};
+		for (auto u = node_id{0}; u < n; ++u) {
+			for (auto const v : adjacency.neighbours(u)) {
+				if (before(u, v)) {
+					later.push_back(v);
+				}
+			}
+			offsets[u + 1] = later.size();
+		}
+		auto const out = [&](node_id u) {
+			return std::span<node_id const>(later.data() + offsets[u], offsets[u + 1] - offsets[u]);
+		};
+
+		auto ret = triangles{std::vector<std::uint64_t>(n, 0), 0, std::vector<double>(n, 0)};
+		auto const add = [&ret](node_id v, std::uint64_t amount) {
+			std::atomic_ref<std::uint64_t>(ret.count[v]).fetch_add(amount, std::memory_order_relaxed);
+		};
+		auto next = std::atomic<std::size_t>{0};
+		auto total = std::atomic<std::uint64_t>{0};
+		if (threads == 0) {
+			threads = detail::default_threads();
+		}
+		detail::parallel_for(threads, threads, [&](std::size_t, std::size_t, std::size_t) {
+			auto local = std::uint64_t{0};
+			for (auto begin = next.fetch_add(detail::triangle_grain); begin < n;
+			     begin = next.fetch_add(detail::triangle_grain)) {
+				auto const end = std::min(n, begin + detail::triangle_grain);
+				for (auto u = static_cast<node_id>(begin); u < end; ++u) {
+					auto through_u = std::uint64_t{0};
+					for (auto const v : out(u)) {
+						auto const common = detail::intersect(out(u), out(v), [&add](node_id w) { add(w, 1); });
+						if (common > 0) {
+							add(v, common);
+							through_u += common;
+						}
+					}
+					if (through_u > 0) {
+						add(u, through_u);
+					}
+					local += through_u;
+				}
+			}
+			total.fetch_add(local, std::memory_order_relaxed);
+		});
+		ret.total = total.load();
+
+		for (auto v = node_id{0}; v < n; ++v) {
+			auto const d = static_cast<double>(adjacency.degree(v));
+			if (d > 1) {
+				ret.clustering[v] = 2.0 * static_cast<double>(ret.count[v]) / (d * (d - 1));
+			}
+		}
+		return ret;
+	}
+
+	/*
+	Triangles of g, indexed by node id, i.e. by position in g.nodes().
+	*/
+	template<typename N, typename E>
+	auto triangle_count(graph<N, E> const& g, std::size_t threads = 0) -> triangles {
+		auto const snapshot = csr(g);
+		return triangle_count(snapshot, snapshot.transpose(), threads);
+	}
+} // namespace gdwg
+
+#endif // GDWG_TRIANGLES_HPP
@@ -0,0 +1,323 @@
+#ifndef GDWG_VIEWS_HPP
+#define GDWG_VIEWS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+Non-owning views over a gdwg::graph.
+A view holds a pointer to the graph it was made from and never copies
+nodes or edges, so the graph must outlive the view and any modification
+of the graph invalidates the view's iterators.
+*/
+namespace gdwg {
+	/*
+	Only the edges of the underlying graph for which
+	pred(src, dst, weight) returns true are visible.
+	All nodes are visible.
+	*/
+	template<typename N, typename E, typename Pred>
+	class filtered_view {
+	public:
+		using graph_type = graph<N, E>;
+		using value_type = typename graph_type::value_type;
+
+		class iterator;
+
+		filtered_view(graph_type const& g, Pred pred)
+		: graph_{&g}, pred_{std::move(pred)} {}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return graph_->is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return graph_->empty();
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return graph_->nodes();
+		}
+
+		/*
+		Given two nodes, return true if there is an edge between them
+		that passes the filter.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::filtered_view<N, E>::is_connected if src or dst node don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			auto const& src_node = graph_->get_node(src);
+			return std::any_of(src_node->second.begin(), src_node->second.end(), [&](auto const& e) {
+				return *(e.dst) == dst && passes(src, e);
+			});
+		}
+
+		/*
+		Return a sequence of weights from src to dst that pass the filter,
+		in ascending order.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::filtered_view<N, E>::weights if src or dst node don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			auto ret = std::vector<E>{};
+			auto const& src_node = graph_->get_node(src);
+			for (auto const& e : src_node->second) {
+				if (*(e.dst) == dst && passes(src, e)) {
+					ret.push_back(*(e.weight));
+				}
+			}
+			return ret;
+		}
+
+		/*
+		Return sequence of nodes in ascending order connected to src
+		by an edge that passes the filter.
+		Throw runtime error if is_node(src) is false
+		*/
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			if (!is_node(src)) {
+				auto error_msg = "Cannot call gdwg::filtered_view<N, E>::connections if src doesn't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			auto ret = std::vector<N>{};
+			auto const& src_node = graph_->get_node(src);
+			// Edges are already ordered by dst, so no sort is needed
+			for (auto const& e : src_node->second) {
+				if (passes(src, e)) {
+					ret.push_back(*(e.dst));
+				}
+			}
+			return ret;
+		}
+
+		// Iterator access
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(this, graph_->begin());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(this, graph_->end());
+		}
+
+		class iterator {
+		public:
+			using value_type = filtered_view::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return *it_;
+			}
+
+			auto operator++() -> iterator& {
+				++it_;
+				skip_filtered();
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return it_ == other.it_;
+			}
+
+		private:
+			filtered_view const* view_ = nullptr;
+			typename graph_type::iterator it_;
+
+			explicit iterator(filtered_view const* view, typename graph_type::iterator it)
+			: view_{view}, it_{it} {
+				skip_filtered();
+			}
+
+			auto skip_filtered() -> void {
+				auto const last = view_->graph_->end();
+				while (it_ != last) {
+					auto const& [from, to, weight] = *it_;
+					if (std::invoke(view_->pred_, from, to, weight)) {
+						return;
+					}
+					++it_;
+				}
+			}
+
+			friend class filtered_view;
+		};
+
+	private:
+		graph_type const* graph_;
+		Pred pred_;
+
+		template<typename Edge>
+		auto passes(N const& src, Edge const& e) const -> bool {
+			return std::invoke(pred_, src, *(e.dst), *(e.weight));
+		}
+	};
+
+	template<typename N, typename E, typename Pred>
+	filtered_view(graph<N, E> const&, Pred) -> filtered_view<N, E, Pred>;
+
+	/*
+	Every edge src->dst of the underlying graph is seen as dst->src.
+	*/
+	template<typename N, typename E>
+	class reverse_view {
+	public:
+		using graph_type = graph<N, E>;
+		using value_type = typename graph_type::value_type;
+
+		class iterator;
+
+		explicit reverse_view(graph_type const& g)
+		: graph_{&g} {}
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return graph_->is_node(value);
+		}
+
+		[[nodiscard]] auto empty() const -> bool {
+			return graph_->empty();
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return graph_->nodes();
+		}
+
+		/*
+		Return true if the underlying graph has an edge dst->src.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::reverse_view<N, E>::is_connected if src or dst node don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			return graph_->is_connected(dst, src);
+		}
+
+		/*
+		Return the weights of the underlying edges dst->src in ascending order.
+		Throw runtime error if either of is_node(src) or is_node(dst) are false
+		*/
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			if (!is_node(src) || !is_node(dst)) {
+				auto error_msg = "Cannot call gdwg::reverse_view<N, E>::weights if src or dst node don't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			return graph_->weights(dst, src);
+		}
+
+		/*
+		Return sequence of nodes in ascending order that have an
+		edge into src in the underlying graph.
+		Throw runtime error if is_node(src) is false
+		Time Complexity : O(n+e), as the graph keeps no incoming index
+		*/
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			if (!is_node(src)) {
+				auto error_msg = "Cannot call gdwg::reverse_view<N, E>::connections if src doesn't exist in the graph";
+				throw std::runtime_error(error_msg);
+			}
+			auto ret = std::vector<N>{};
+			// Nodes are visited in ascending order, so the result is already sorted
+			for (auto const& i : graph_->graph_) {
+				for (auto const& e : i.second) {
+					if (*(e.dst) == src) {
+						ret.push_back(*(i.first));
+					}
+				}
+			}
+			return ret;
+		}
+
+		// Iterator access
+		/*
+		Edges are visited in the order of the underlying graph,
+		i.e. ordered by their dst, src and weight in the view.
+		*/
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(graph_->begin());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(graph_->end());
+		}
+
+		class iterator {
+		public:
+			using value_type = reverse_view::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				auto [from, to, weight] = *it_;
+				return {std::move(to), std::move(from), std::move(weight)};
+			}
+
+			auto operator++() -> iterator& {
+				++it_;
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+
+			auto operator--() -> iterator& {
+				--it_;
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			auto operator==(iterator const& other) const -> bool {
+				return it_ == other.it_;
+			}
+
+		private:
+			typename graph_type::iterator it_;
+
+			explicit iterator(typename graph_type::iterator it)
+			: it_{it} {}
+
+			friend class reverse_view;
+		};
+
+	private:
+		graph_type const* graph_;
+	};
+} // namespace gdwg
+
+#endif // GDWG_VIEWS_HPP
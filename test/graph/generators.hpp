@@ -0,0 +1,45 @@
+#ifndef GDWG_TEST_GENERATORS_HPP
+#define GDWG_TEST_GENERATORS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <random>
+#include <type_traits>
+
+/*
+Random graphs shared by the tests.
+Every generator is seeded, so failures are repeatable.
+*/
+namespace gdwg::test {
+	/*
+	Nodes 0 to n - 1 and the given number of edge inserts between
+	uniformly chosen endpoints, weighted uniformly from min_weight to
+	max_weight inclusive. Self loops are kept; a repeated edge with the
+	same weight is only inserted once.
+	*/
+	template<typename E = int>
+	auto random_graph(int n, int edges, unsigned seed, E min_weight = E{1}, E max_weight = E{1}) -> graph<int, E> {
+		auto g = graph<int, E>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		auto random = std::mt19937(seed);
+		auto node = std::uniform_int_distribution<int>(0, n - 1);
+		auto weight = [&] {
+			if constexpr (std::is_integral_v<E>) {
+				return std::uniform_int_distribution<E>(min_weight, max_weight);
+			}
+			else {
+				return std::uniform_real_distribution<E>(min_weight, max_weight);
+			}
+		}();
+		for (auto i = 0; i < edges; ++i) {
+			auto const from = node(random);
+			auto const to = node(random);
+			g.insert_edge(from, to, weight(random));
+		}
+		return g;
+	}
+} // namespace gdwg::test
+
+#endif // GDWG_TEST_GENERATORS_HPP
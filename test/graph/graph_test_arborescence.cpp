@@ -0,0 +1,114 @@
+#include "gdwg/arborescence.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	/*
+	Cheapest arborescence by trying every choice of incoming edge for
+	every node the root reaches
+	*/
+	auto brute_force(gdwg::csr<int, int> const& g, gdwg::node_id root) -> int {
+		auto const reverse = g.transpose();
+		auto const n = static_cast<gdwg::node_id>(g.size());
+		auto best = std::numeric_limits<int>::max();
+		auto choice = std::vector<std::size_t>(n, 0);
+		auto const reachable = gdwg::min_arborescence(g, root).parent;
+		while (true) {
+			auto total = 0;
+			auto valid = true;
+			auto parent = std::vector<gdwg::node_id>(n, gdwg::no_node);
+			for (auto v = gdwg::node_id{0}; v < n && valid; ++v) {
+				if (v == root || reachable[v] == gdwg::no_node) {
+					continue;
+				}
+				auto const k = reverse.offsets()[v] + choice[v];
+				valid = k < reverse.offsets()[v + 1];
+				if (valid) {
+					parent[v] = reverse.targets()[k];
+					total += reverse.weights()[k];
+				}
+			}
+			// Every chosen parent chain must end at the root
+			for (auto v = gdwg::node_id{0}; v < n && valid; ++v) {
+				auto u = v;
+				for (auto steps = gdwg::node_id{0}; valid && u != root && parent[u] != gdwg::no_node; ++steps) {
+					u = parent[u];
+					valid = steps <= n;
+				}
+				valid = valid && (u == root || reachable[v] == gdwg::no_node);
+			}
+			if (valid && total < best) {
+				best = total;
+			}
+			// Next combination
+			auto v = gdwg::node_id{0};
+			for (; v < n; ++v) {
+				if (++choice[v] <= reverse.degree(v)) {
+					break;
+				}
+				choice[v] = 0;
+			}
+			if (v == n) {
+				return best;
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("min_arborescence on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"r", "a", "b", "c", "x"};
+	g.insert_edge("r", "a", 5);
+	g.insert_edge("r", "b", 1);
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("b", "c", 5);
+	g.insert_edge("c", "a", -1);
+	g.insert_edge("c", "c", -9);
+	g.insert_edge("x", "a", -5);
+
+	auto const edges = gdwg::min_arborescence(g, std::string("r"));
+	REQUIRE(edges.size() == 3);
+	CHECK(edges[0].from == "a");
+	CHECK(edges[0].to == "c");
+	CHECK(edges[0].weight == 2);
+	CHECK(edges[1].from == "b");
+	CHECK(edges[1].to == "a");
+	CHECK(edges[2].from == "r");
+	CHECK(edges[2].to == "b");
+
+	auto const tree = gdwg::min_arborescence(gdwg::csr(g), 3);
+	CHECK(tree.total == 4);
+	// "x" cannot be reached from "r"
+	CHECK(tree.parent[4] == gdwg::no_node);
+	CHECK(tree.parent[3] == 3);
+
+	CHECK_THROWS(gdwg::min_arborescence(g, std::string("z")));
+}
+
+TEST_CASE("min_arborescence matches brute force") {
+	auto random = std::mt19937(42);
+	for (auto trial = 0; trial < 150; ++trial) {
+		auto g = gdwg::graph<int, int>{};
+		auto const n = 2 + trial % 5;
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		auto const edges = n + static_cast<int>(random() % 6);
+		for (auto e = 0; e < edges; ++e) {
+			g.insert_edge(static_cast<int>(random() % n),
+			              static_cast<int>(random() % n),
+			              static_cast<int>(random() % 21) - 6);
+		}
+		auto const s = gdwg::csr(g);
+		auto const root = static_cast<gdwg::node_id>(random() % n);
+		CHECK(gdwg::min_arborescence(s, root).total == brute_force(s, root));
+	}
+}
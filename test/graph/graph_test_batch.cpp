@@ -0,0 +1,72 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+Same as calling connections(src) for every src,
+flattened into one buffer in the order the srcs were given
+*/
+TEST_CASE("connections_batch") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("c", "d", 4);
+
+	auto const srcs = std::vector<std::string>{"c", "a", "d", "a"};
+	auto const out = g.connections_batch(srcs);
+
+	REQUIRE(out.size() == srcs.size());
+	for (auto i = std::size_t{0}; i < srcs.size(); ++i) {
+		auto const expected = g.connections(srcs[i]);
+		CHECK(std::vector<std::string>(out[i].begin(), out[i].end()) == expected);
+	}
+	CHECK(out.offsets == std::vector<std::size_t>{0, 1, 4, 4, 7});
+
+	// Reusing a buffer replaces its contents
+	auto buffer = out;
+	g.connections_batch(std::vector<std::string>{"b"}, buffer);
+	CHECK(buffer.size() == 1);
+	CHECK(buffer[0].empty());
+
+	// An empty batch gives an empty result
+	CHECK(g.connections_batch(std::vector<std::string>{}).size() == 0);
+
+	// As node z is not present, it will throw runtime error
+	CHECK_THROWS(g.connections_batch(std::vector<std::string>{"a", "z"}));
+}
+
+/*
+Same as calling is_connected(src, dst) for every pair,
+answered in the order the pairs were given
+*/
+TEST_CASE("is_connected_batch") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(1, 4, 1);
+	g.insert_edge(3, 3, 1);
+	g.insert_edge(5, 1, 1);
+
+	auto const pairs = std::vector<std::pair<int, int>>{
+	   {5, 1},
+	   {1, 4},
+	   {1, 3},
+	   {3, 3},
+	   {1, 2},
+	   {2, 1},
+	   {1, 4},
+	   {1, 5},
+	};
+	auto const out = g.is_connected_batch(pairs);
+	REQUIRE(out.size() == pairs.size());
+	for (auto i = std::size_t{0}; i < pairs.size(); ++i) {
+		CHECK(out[i] == g.is_connected(pairs[i].first, pairs[i].second));
+	}
+
+	// As the following nodes are not present, it will throw runtime error
+	CHECK_THROWS(g.is_connected_batch(std::vector<std::pair<int, int>>{{1, 2}, {9, 1}}));
+	CHECK_THROWS(g.is_connected_batch(std::vector<std::pair<int, int>>{{1, 9}}));
+}
@@ -0,0 +1,96 @@
+#include "gdwg/bellman_ford.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+	// Sum of the weights around cycle, taking the cheapest parallel edge
+	auto cycle_weight(gdwg::graph<int, int> const& g, std::vector<gdwg::node_id> const& cycle) {
+		auto const nodes = g.nodes();
+		auto total = 0;
+		for (auto i = std::size_t{0}; i < cycle.size(); ++i) {
+			auto const from = nodes[cycle[i]];
+			auto const to = nodes[cycle[(i + 1) % cycle.size()]];
+			auto const weights = g.weights(from, to);
+			REQUIRE(!weights.empty());
+			total += weights.front();
+		}
+		return total;
+	}
+} // namespace
+
+/*
+Shortest paths with negative weights but no negative cycle
+*/
+TEST_CASE("bellman_ford and spfa with negative weights") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "c", 5);
+	g.insert_edge("c", "b", -3);
+	g.insert_edge("b", "d", 2);
+	g.insert_edge("d", "c", 1);
+
+	for (auto const& r : {gdwg::bellman_ford(g, std::string("a")), gdwg::spfa(g, std::string("a"))}) {
+		CHECK(!r.has_negative_cycle());
+		CHECK(r.paths.distance == std::vector<int>{0, 2, 5, 4, gdwg::detail::infinity<int>()});
+		CHECK(r.paths.path(3) == std::vector<gdwg::node_id>{0, 2, 1, 3});
+		CHECK(!r.paths.reached(4));
+	}
+
+	CHECK_THROWS(gdwg::bellman_ford(g, std::string("z")));
+	CHECK_THROWS(gdwg::spfa(g, std::string("z")));
+}
+
+/*
+A reachable negative cycle is detected and reported in edge order
+*/
+TEST_CASE("negative cycle detection") {
+	auto g = gdwg::graph<int, int>{0, 1, 2, 3, 4, 5};
+	g.insert_edge(0, 1, 1);
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(2, 3, -4);
+	g.insert_edge(3, 1, 2);
+	g.insert_edge(3, 4, 1);
+
+	for (auto const& r : {gdwg::bellman_ford(g, 0), gdwg::spfa(g, 0)}) {
+		REQUIRE(r.has_negative_cycle());
+		CHECK(r.negative_cycle.size() == 3);
+		CHECK(cycle_weight(g, r.negative_cycle) < 0);
+	}
+
+	// A negative cycle that cannot be reached from the source is not reported
+	auto h = gdwg::graph<int, int>{0, 1, 2};
+	h.insert_edge(1, 2, -1);
+	h.insert_edge(2, 1, -1);
+	CHECK(!gdwg::bellman_ford(h, 0).has_negative_cycle());
+	CHECK(!gdwg::spfa(h, 0).has_negative_cycle());
+
+	// A negative self-loop on the source is a cycle of its own
+	h.insert_edge(0, 0, -1);
+	CHECK(gdwg::bellman_ford(h, 0).negative_cycle == std::vector<gdwg::node_id>{0});
+	CHECK(gdwg::spfa(h, 0).negative_cycle == std::vector<gdwg::node_id>{0});
+}
+
+/*
+Both match Dijkstra on non-negative weights
+*/
+TEST_CASE("bellman_ford matches dijkstra") {
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 200; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 200; ++i) {
+		for (auto j = 1; j <= 4; ++j) {
+			g.insert_edge(i, (i * 37 + j * 11) % 200, (i * j) % 17);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	auto const expected = gdwg::dijkstra(s, 0).distance;
+	CHECK(gdwg::bellman_ford(s, 0).paths.distance == expected);
+	CHECK(gdwg::spfa(s, 0).paths.distance == expected);
+}
@@ -0,0 +1,152 @@
+#include "generators.hpp"
+
+#include "gdwg/betweenness.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+	auto constexpr unreached = std::numeric_limits<long>::max() / 4;
+
+	// Count shortest paths pair by pair over a matrix of the lightest edges
+	auto naive_betweenness(gdwg::graph<int, int> const& g, bool weighted) -> std::vector<double> {
+		auto const nodes = g.nodes();
+		auto const n = nodes.size();
+		auto w = std::vector<std::vector<long>>(n, std::vector<long>(n, unreached));
+		for (auto const& [from, to, weight] : g) {
+			if (from != to) {
+				auto const step = weighted ? long{weight} : 1L;
+				w[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] =
+				   std::min(w[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)], step);
+			}
+		}
+		auto dist = w;
+		for (auto v = std::size_t{0}; v < n; ++v) {
+			dist[v][v] = 0;
+		}
+		for (auto k = std::size_t{0}; k < n; ++k) {
+			for (auto i = std::size_t{0}; i < n; ++i) {
+				for (auto j = std::size_t{0}; j < n; ++j) {
+					dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+				}
+			}
+		}
+		// sigma[s][t] is the number of shortest s-t paths, filled in distance order
+		auto sigma = std::vector<std::vector<double>>(n, std::vector<double>(n, 0));
+		for (auto s = std::size_t{0}; s < n; ++s) {
+			auto order = std::vector<std::size_t>{};
+			for (auto t = std::size_t{0}; t < n; ++t) {
+				if (dist[s][t] < unreached) {
+					order.push_back(t);
+				}
+			}
+			std::sort(order.begin(), order.end(), [&](auto a, auto b) { return dist[s][a] < dist[s][b]; });
+			sigma[s][s] = 1;
+			for (auto const t : order) {
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					if (t != s && w[u][t] < unreached && dist[s][u] + w[u][t] == dist[s][t]) {
+						sigma[s][t] += sigma[s][u];
+					}
+				}
+			}
+		}
+		auto ret = std::vector<double>(n, 0);
+		for (auto s = std::size_t{0}; s < n; ++s) {
+			for (auto t = std::size_t{0}; t < n; ++t) {
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					if (s != t && v != s && v != t && dist[s][t] < unreached
+					    && dist[s][v] + dist[v][t] == dist[s][t])
+					{
+						ret[v] += sigma[s][v] * sigma[v][t] / sigma[s][t];
+					}
+				}
+			}
+		}
+		return ret;
+	}
+
+	auto check_close(std::vector<double> const& got, std::vector<double> const& expected) -> void {
+		REQUIRE(got.size() == expected.size());
+		for (auto v = std::size_t{0}; v < got.size(); ++v) {
+			CHECK(got[v] == Approx(expected[v]).margin(1e-9));
+		}
+	}
+} // namespace
+
+TEST_CASE("betweenness on a path and a diamond") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	// Two equally short routes a->b->d and a->c->d, then d->e
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "e", 1);
+
+	auto const unweighted = gdwg::betweenness(g);
+	CHECK(unweighted.sources == 5);
+	CHECK(unweighted.error_bound == 0);
+	// b and c each carry half of a->d and a->e; d carries a->e, b->e, c->e
+	CHECK(unweighted.centrality == std::vector<double>{0, 1, 1, 3, 0});
+
+	// Making a->c heavy sends every weighted path through b
+	g.insert_edge("a", "c", 5);
+	g.erase_edge("a", "c", 1);
+	auto const weighted = gdwg::betweenness(g, {.weighted = true});
+	CHECK(weighted.centrality == std::vector<double>{0, 2, 0, 3, 0});
+}
+
+TEST_CASE("betweenness matches counting every shortest path") {
+	for (auto const seed : {1u, 2u, 3u}) {
+		auto const g = gdwg::test::random_graph(40, 120, seed, 1, 4);
+		auto const s = gdwg::csr(g);
+		auto const reverse = s.transpose();
+		for (auto const weighted : {false, true}) {
+			auto const expected = naive_betweenness(g, weighted);
+			for (auto const threads : {std::size_t{1}, std::size_t{3}}) {
+				auto const got = gdwg::betweenness(s, reverse, {.weighted = weighted, .threads = threads});
+				check_close(got.centrality, expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("betweenness sampling") {
+	auto const g = gdwg::test::random_graph(60, 240, 7, 1, 4);
+	auto const s = gdwg::csr(g);
+	auto const reverse = s.transpose();
+	auto const exact = gdwg::betweenness(s, reverse);
+
+	SECTION("sampling every node is exact") {
+		auto const all = gdwg::betweenness(s, reverse, {.samples = 60});
+		CHECK(all.sources == 60);
+		CHECK(all.error_bound == 0);
+		check_close(all.centrality, exact.centrality);
+	}
+
+	SECTION("a sample stays within its error bound") {
+		auto const sampled = gdwg::betweenness(s, reverse, {.samples = 20, .seed = 11, .threads = 2});
+		CHECK(sampled.sources == 20);
+		CHECK(sampled.error_bound > 0);
+		for (auto v = std::size_t{0}; v < exact.centrality.size(); ++v) {
+			CHECK(std::abs(sampled.centrality[v] - exact.centrality[v]) <= sampled.error_bound);
+		}
+		// The same seed picks the same sources
+		auto const again = gdwg::betweenness(s, reverse, {.samples = 20, .seed = 11, .threads = 1});
+		check_close(again.centrality, sampled.centrality);
+	}
+}
+
+TEST_CASE("betweenness rejects negative weights when weighted") {
+	auto g = gdwg::graph<int, int>{0, 1};
+	g.insert_edge(0, 1, -1);
+	CHECK_THROWS_WITH(gdwg::betweenness(g, {.weighted = true}),
+	                  "Cannot call gdwg::betweenness with weighted edges on negative edge weights");
+	CHECK_NOTHROW(gdwg::betweenness(g));
+}
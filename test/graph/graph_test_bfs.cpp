@@ -0,0 +1,119 @@
+#include "generators.hpp"
+
+#include "gdwg/bfs.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+	// Plain queue-based BFS over connections() to check against
+	auto reference_bfs(gdwg::graph<int, int> const& g, int src) {
+		auto const nodes = g.nodes();
+		auto dist = std::vector<std::uint32_t>(nodes.size(), gdwg::detail::infinity<std::uint32_t>());
+		auto queue = std::deque<int>{src};
+		dist[static_cast<std::size_t>(src)] = 0;
+		while (!queue.empty()) {
+			auto const u = queue.front();
+			queue.pop_front();
+			for (auto const v : g.connections(u)) {
+				if (dist[static_cast<std::size_t>(v)] == gdwg::detail::infinity<std::uint32_t>()) {
+					dist[static_cast<std::size_t>(v)] = dist[static_cast<std::size_t>(u)] + 1;
+					queue.push_back(v);
+				}
+			}
+		}
+		return dist;
+	}
+} // namespace
+
+/*
+Hop distances and parents from a single source
+*/
+TEST_CASE("bfs") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 1);
+
+	auto const r = gdwg::bfs(g, std::string("a"));
+	CHECK(r.distance[0] == 0);
+	CHECK(r.distance[1] == 1);
+	CHECK(r.distance[2] == 1);
+	CHECK(r.distance[3] == 2);
+	CHECK(!r.reached(4));
+	CHECK(r.path(3) == std::vector<gdwg::node_id>{0, 2, 3});
+
+	CHECK_THROWS(gdwg::bfs(g, std::string("z")));
+	auto const snapshot = gdwg::csr(g);
+	CHECK_THROWS(gdwg::bfs(snapshot, snapshot.transpose(), 0, 1, 0, 24));
+	CHECK_THROWS(gdwg::bfs(snapshot, snapshot.transpose(), 0, 1, 14, 0));
+}
+
+/*
+Distances match a plain BFS whichever direction each step takes,
+and every parent is one hop closer along a real edge
+*/
+TEST_CASE("direction-optimizing bfs matches reference") {
+	// Sparse enough to stay top-down, and dense enough to go bottom-up
+	for (auto const edges : {3000, 60000}) {
+		auto const g = gdwg::test::random_graph(5000, edges, 42);
+		auto const snapshot = gdwg::csr(g);
+		auto const reverse = snapshot.transpose();
+		auto const expected = reference_bfs(g, 0);
+
+		for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+			auto const r = gdwg::bfs(snapshot, reverse, 0, threads);
+			CHECK(r.distance == expected);
+			for (auto v = gdwg::node_id{1}; v < snapshot.size(); ++v) {
+				if (r.reached(v)) {
+					auto const u = r.predecessor[v];
+					CHECK(r.distance[u] + 1 == r.distance[v]);
+					CHECK(g.is_connected(static_cast<int>(u), static_cast<int>(v)));
+				}
+			}
+		}
+
+		// Forcing either direction throughout gives the same distances
+		CHECK(gdwg::bfs(snapshot, reverse, 0, 4, 1000000000, 1000000000).distance == expected);
+		CHECK(gdwg::bfs(snapshot, reverse, 0, 4, 1, 1000000000).distance == expected);
+	}
+}
+
+/*
+A wide level split across threads followed by narrow levels run on
+one thread: nothing left over from the wide level may come back
+*/
+TEST_CASE("bfs frontier shrinking below the parallel grain") {
+	auto const leaves = static_cast<int>(2 * gdwg::detail::bfs_grain);
+	auto const hub = leaves + 1;
+	auto const chain = 5;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i <= hub + chain; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 1; i <= leaves; ++i) {
+		g.insert_edge(0, i, 1);
+		g.insert_edge(i, hub, 1);
+	}
+	for (auto i = hub; i < hub + chain; ++i) {
+		g.insert_edge(i, i + 1, 1);
+	}
+	auto const snapshot = gdwg::csr(g);
+	auto const reverse = snapshot.transpose();
+	auto const expected = reference_bfs(g, 0);
+
+	// Stay top-down throughout, so every level goes through the frontier lists
+	auto const r = gdwg::bfs(snapshot, reverse, 0, 4, 1000000000, 1000000000);
+	CHECK(r.distance == expected);
+	CHECK(r.distance[static_cast<std::size_t>(hub)] == 2);
+	CHECK(r.distance[static_cast<std::size_t>(hub + chain)] == 2 + chain);
+	for (auto v = gdwg::node_id{1}; v < snapshot.size(); ++v) {
+		CHECK(r.distance[r.predecessor[v]] + 1 == r.distance[v]);
+	}
+}
@@ -0,0 +1,161 @@
+#include "gdwg/communities.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	template<typename G>
+	concept detects_communities = requires(G const& g) {
+		gdwg::louvain(g);
+		gdwg::label_propagation(g);
+	};
+
+	/*
+	groups cliques of size members, each joined to the next by one light
+	edge; clique edges point one way only, as the direction is ignored.
+	*/
+	auto ring_of_cliques(int groups, int size) -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{};
+		for (auto i = 0; i < groups * size; ++i) {
+			g.insert_node(i);
+		}
+		for (auto c = 0; c < groups; ++c) {
+			for (auto i = 0; i < size; ++i) {
+				for (auto j = i + 1; j < size; ++j) {
+					g.insert_edge(c * size + i, c * size + j, 1.0);
+				}
+			}
+			g.insert_edge(c * size, ((c + 1) % groups) * size + 1, 0.1);
+		}
+		return g;
+	}
+
+	// Modularity straight from the definition over every pair of nodes
+	auto naive_modularity(gdwg::graph<int, double> const& g, std::vector<gdwg::node_id> const& community) -> double {
+		auto const n = g.nodes().size();
+		auto a = std::vector<std::vector<double>>(n, std::vector<double>(n, 0));
+		for (auto const& [from, to, weight] : g) {
+			a[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)] += weight;
+			a[static_cast<std::size_t>(to)][static_cast<std::size_t>(from)] += weight;
+		}
+		auto k = std::vector<double>(n, 0);
+		auto two_m = 0.0;
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				k[u] += a[u][v];
+			}
+			two_m += k[u];
+		}
+		auto ret = 0.0;
+		for (auto u = std::size_t{0}; u < n; ++u) {
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				if (community[u] == community[v]) {
+					ret += a[u][v] - k[u] * k[v] / two_m;
+				}
+			}
+		}
+		return ret / two_m;
+	}
+
+	// Every clique must be one community, and different cliques different ones
+	auto check_cliques(gdwg::communities const& result, int groups, int size) -> void {
+		REQUIRE(result.count == static_cast<std::size_t>(groups));
+		for (auto c = 0; c < groups; ++c) {
+			for (auto i = 0; i < size; ++i) {
+				CHECK(result.community[static_cast<std::size_t>(c * size + i)] == static_cast<gdwg::node_id>(c));
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("modularity matches its definition") {
+	auto g = ring_of_cliques(3, 4);
+	// A self-loop and a parallel edge in the other direction
+	g.insert_edge(5, 5, 2.0);
+	g.insert_edge(1, 0, 0.5);
+	auto const s = gdwg::csr(g);
+	auto const reverse = s.transpose();
+	auto const by_clique = std::vector<gdwg::node_id>{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2};
+	auto const halves = std::vector<gdwg::node_id>{0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1};
+	CHECK(gdwg::modularity(s, reverse, by_clique) == Approx(naive_modularity(g, by_clique)));
+	CHECK(gdwg::modularity(s, reverse, halves) == Approx(naive_modularity(g, halves)));
+	CHECK(gdwg::modularity(s, reverse, std::vector<gdwg::node_id>(12, 0)) == Approx(0.0).margin(1e-12));
+}
+
+TEST_CASE("louvain finds a ring of cliques") {
+	auto const g = ring_of_cliques(8, 6);
+	auto const result = gdwg::louvain(g);
+	check_cliques(result, 8, 6);
+	CHECK(result.iterations >= 1);
+	CHECK(result.modularity == Approx(naive_modularity(g, result.community)));
+}
+
+TEST_CASE("label_propagation finds a ring of cliques") {
+	auto const g = gdwg::csr(ring_of_cliques(8, 6));
+	auto const reverse = g.transpose();
+	for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+		auto const result = gdwg::label_propagation(g, reverse, {.threads = threads});
+		check_cliques(result, 8, 6);
+		CHECK(result.modularity == Approx(gdwg::modularity(g, reverse, result.community)));
+	}
+}
+
+TEST_CASE("edge weights decide the communities") {
+	// A path a-b-c-d whose heavy edges pair a with b and c with d
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 10);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "d", 10);
+	auto const weighted = gdwg::louvain(g);
+	CHECK(weighted.community == std::vector<gdwg::node_id>{0, 0, 1, 1});
+	CHECK(weighted.modularity > 0.4);
+	// Without weights the split is worth less
+	auto const s = gdwg::csr(g);
+	CHECK(gdwg::modularity(s, s.transpose(), weighted.community, {.weighted = false})
+	      < weighted.modularity);
+}
+
+TEST_CASE("louvain beats label propagation on a noisy graph") {
+	auto g = ring_of_cliques(10, 8);
+	auto random = std::mt19937(3);
+	auto node = std::uniform_int_distribution<int>(0, 79);
+	for (auto i = 0; i < 60; ++i) {
+		g.insert_edge(node(random), node(random), 1.0);
+	}
+	auto const s = gdwg::csr(g);
+	auto const reverse = s.transpose();
+	auto const louvain = gdwg::louvain(s, reverse);
+	auto const propagation = gdwg::label_propagation(s, reverse, {.threads = 1});
+	CHECK(louvain.modularity == Approx(naive_modularity(g, louvain.community)));
+	CHECK(louvain.modularity >= propagation.modularity - 1e-9);
+	CHECK(louvain.modularity > 0.6);
+}
+
+TEST_CASE("communities on graphs without edges") {
+	auto const g = gdwg::graph<int, int>{1, 2, 3};
+	auto const result = gdwg::louvain(g);
+	CHECK(result.count == 3);
+	CHECK(result.modularity == 0);
+	CHECK(gdwg::label_propagation(g).count == 3);
+	CHECK(gdwg::louvain(gdwg::graph<int, int>{}).count == 0);
+}
+
+TEST_CASE("communities reject negative weights") {
+	auto g = gdwg::graph<int, int>{1, 2};
+	g.insert_edge(1, 2, -1);
+	CHECK_THROWS_WITH(gdwg::louvain(g),
+	                  "Cannot call gdwg::louvain or gdwg::label_propagation with weighted edges on negative edge "
+	                  "weights");
+	CHECK_NOTHROW(gdwg::louvain(g, {.weighted = false}));
+}
+
+TEST_CASE("communities need weights convertible to double") {
+	STATIC_REQUIRE(detects_communities<gdwg::graph<int, int>>);
+	STATIC_REQUIRE(detects_communities<gdwg::graph<std::string, double>>);
+	STATIC_REQUIRE(!detects_communities<gdwg::graph<std::string, std::string>>);
+}
@@ -0,0 +1,80 @@
+#include "gdwg/connected_components.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Components by breadth-first search ignoring direction, numbered by smallest node
+	template<typename N, typename E>
+	auto reference(gdwg::csr<N, E> const& g) -> std::vector<gdwg::node_id> {
+		auto const reverse = g.transpose();
+		auto ret = std::vector<gdwg::node_id>(g.size(), gdwg::no_node);
+		auto count = gdwg::node_id{0};
+		for (auto s = gdwg::node_id{0}; s < g.size(); ++s) {
+			if (ret[s] != gdwg::no_node) {
+				continue;
+			}
+			auto queue = std::vector<gdwg::node_id>{s};
+			ret[s] = count;
+			for (auto i = std::size_t{0}; i < queue.size(); ++i) {
+				for (auto const* adjacency : {&g, &reverse}) {
+					for (auto const v : adjacency->neighbours(queue[i])) {
+						if (ret[v] == gdwg::no_node) {
+							ret[v] = count;
+							queue.push_back(v);
+						}
+					}
+				}
+			}
+			++count;
+		}
+		return ret;
+	}
+} // namespace
+
+TEST_CASE("weakly_connected_components ignores direction") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("b", "a", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("d", "e", 1);
+	g.insert_edge("f", "f", 1);
+	auto const wcc = gdwg::weakly_connected_components(g);
+	CHECK(wcc.count == 3);
+	CHECK(wcc.component == std::vector<gdwg::node_id>{0, 0, 0, 1, 1, 2});
+
+	CHECK(gdwg::weakly_connected_components(gdwg::graph<int, int>{}).count == 0);
+}
+
+/*
+One giant component, which sampling should pick and skip, plus many
+small islands whose only links point into or out of it the other way
+*/
+TEST_CASE("weakly_connected_components matches a reference") {
+	auto const n = 3000;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 2000; ++i) {
+		g.insert_edge(i, (i * 7 + 1) % 2000, 1);
+		g.insert_edge(i, (i * 13 + 5) % 2000, 1);
+	}
+	for (auto i = 2000; i < n; i += 5) {
+		g.insert_edge(i, i + 1, 1);
+		g.insert_edge(i + 2, i + 1, 1);
+		// Edges from the giant component are the islands' only link to it
+		if (i % 3 == 0) {
+			g.insert_edge((i * 3) % 2000, i + 3, 1);
+			g.insert_edge((i * 5) % 2000, i, 1);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	auto const expected = reference(s);
+	for (auto const threads : {1, 4}) {
+		CHECK(gdwg::weakly_connected_components(s, s.transpose(), threads).component == expected);
+	}
+}
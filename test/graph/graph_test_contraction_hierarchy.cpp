@@ -0,0 +1,153 @@
+#include "generators.hpp"
+
+#include "gdwg/contraction_hierarchy.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	// A grid with roads in both directions, like a small road network
+	auto grid(int side, unsigned seed) -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{};
+		for (auto i = 0; i < side * side; ++i) {
+			g.insert_node(i);
+		}
+		auto random = std::mt19937(seed);
+		auto length = std::uniform_real_distribution<double>(1.0, 10.0);
+		for (auto r = 0; r < side; ++r) {
+			for (auto c = 0; c < side; ++c) {
+				auto const u = r * side + c;
+				if (c + 1 < side) {
+					g.insert_edge(u, u + 1, length(random));
+					g.insert_edge(u + 1, u, length(random));
+				}
+				if (r + 1 < side) {
+					g.insert_edge(u, u + side, length(random));
+					g.insert_edge(u + side, u, length(random));
+				}
+			}
+		}
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto check_all_pairs(gdwg::csr<N, E> const& g, gdwg::contraction_hierarchy<E> const& ch) -> void {
+		auto ws = typename gdwg::contraction_hierarchy<E>::workspace{};
+		for (auto src = gdwg::node_id{0}; src < g.size(); ++src) {
+			auto const expected = gdwg::dijkstra(g, src).distance;
+			for (auto dst = gdwg::node_id{0}; dst < g.size(); ++dst) {
+				auto const got = ch.distance(src, dst, ws);
+				if (expected[dst] == gdwg::detail::infinity<E>()) {
+					REQUIRE(got == expected[dst]);
+				}
+				else {
+					// Shortcuts sum the weights in a different order
+					REQUIRE(got == Approx(expected[dst]));
+				}
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("contraction_hierarchy answers like dijkstra on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("a", "c", 5);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 3);
+	g.insert_edge("d", "d", 0);
+
+	auto const ch = gdwg::contraction_hierarchy(g);
+	CHECK(ch.size() == 5);
+	auto ws = decltype(ch)::workspace{};
+	CHECK(ch.distance(0, 3, ws) == 4);
+	CHECK(ch.distance(3, 2, ws) == 6);
+	CHECK(ch.distance(2, 2, ws) == 0);
+	// e is isolated
+	CHECK(ch.distance(0, 4, ws) == gdwg::detail::infinity<int>());
+	CHECK(ch.distance(4, 0, ws) == gdwg::detail::infinity<int>());
+}
+
+TEST_CASE("contraction_hierarchy matches dijkstra on every pair") {
+	SECTION("random graphs with zero weights") {
+		for (auto const seed : {1u, 2u, 3u}) {
+			auto const g = gdwg::csr(gdwg::test::random_graph(60, 200, seed, 0, 20));
+			check_all_pairs(g, gdwg::contraction_hierarchy(g));
+		}
+	}
+
+	SECTION("a grid") {
+		auto const g = gdwg::csr(grid(12, 5));
+		auto const ch = gdwg::contraction_hierarchy(g);
+		check_all_pairs(g, ch);
+		CHECK(ch.num_edges() == g.num_edges() + ch.num_shortcuts());
+	}
+}
+
+TEST_CASE("contraction_hierarchy save and load") {
+	auto const g = gdwg::csr(grid(8, 3));
+	auto const ch = gdwg::contraction_hierarchy(g);
+	auto stream = std::stringstream{};
+	ch.save(stream);
+
+	auto const loaded = gdwg::contraction_hierarchy<double>::load(stream);
+	CHECK(loaded == ch);
+	check_all_pairs(g, loaded);
+
+	SECTION("a different weight type is rejected") {
+		stream.clear();
+		stream.seekg(0);
+		CHECK_THROWS_WITH(gdwg::contraction_hierarchy<float>::load(stream),
+		                  "Cannot call gdwg::contraction_hierarchy<E>::load on a stream that does not hold a "
+		                  "contraction hierarchy of this weight type");
+	}
+
+	SECTION("a truncated or tampered stream is rejected") {
+		auto const error = "Cannot call gdwg::contraction_hierarchy<E>::load on a truncated or corrupt stream";
+		auto const bytes = stream.str();
+		auto truncated = std::stringstream{bytes.substr(0, bytes.size() - 8)};
+		CHECK_THROWS_WITH(gdwg::contraction_hierarchy<double>::load(truncated), error);
+
+		// The layout is an 8 byte magic, 5 header words, then the up offsets and targets
+		auto const n = g.size();
+		auto const header = std::size_t{8};
+		auto const up_offsets = header + 5 * sizeof(std::uint64_t);
+		auto const up_targets = up_offsets + (n + 1) * sizeof(std::uint64_t);
+		auto const tampered = [&bytes](std::size_t at, auto value) {
+			auto ret = bytes;
+			std::memcpy(ret.data() + at, &value, sizeof(value));
+			return std::stringstream{ret};
+		};
+
+		// An edge count far beyond the data, padded out to match the old length
+		auto too_many = tampered(header + 2 * sizeof(std::uint64_t), std::uint64_t{1} << 40);
+		CHECK_THROWS_WITH(gdwg::contraction_hierarchy<double>::load(too_many), error);
+		// Offsets that run backwards
+		auto backwards = tampered(up_offsets + sizeof(std::uint64_t), std::uint64_t{1} << 20);
+		CHECK_THROWS_WITH(gdwg::contraction_hierarchy<double>::load(backwards), error);
+		// A target that is not a node
+		auto outside = tampered(up_targets, static_cast<gdwg::node_id>(n));
+		CHECK_THROWS_WITH(gdwg::contraction_hierarchy<double>::load(outside), error);
+		// Trailing bytes after a valid hierarchy are left in the stream
+		auto padded = std::stringstream{bytes + std::string(64, '\0')};
+		CHECK(gdwg::contraction_hierarchy<double>::load(padded) == ch);
+	}
+}
+
+TEST_CASE("contraction_hierarchy rejects negative weights") {
+	auto g = gdwg::graph<int, int>{0, 1};
+	g.insert_edge(0, 1, -1);
+	CHECK_THROWS_WITH(gdwg::contraction_hierarchy(g),
+	                  "Cannot call gdwg::contraction_hierarchy<E> on a graph with negative edge weights");
+}
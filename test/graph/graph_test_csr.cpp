@@ -0,0 +1,57 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+/*
+Nodes get dense ids in ascending order and each node's outgoing
+edges are a contiguous, ordered slice of the target and weight arrays
+*/
+TEST_CASE("csr snapshot") {
+	auto g = gdwg::graph<std::string, int>{"d", "b", "a", "c"};
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("a", "b", 9);
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("c", "a", 4);
+	g.insert_edge("d", "d", 0);
+
+	auto const s = gdwg::csr(g);
+	CHECK(s.size() == 4);
+	CHECK(s.num_edges() == 5);
+	CHECK(s.nodes() == g.nodes());
+	CHECK(s.id("a") == 0);
+	CHECK(s.id("d") == 3);
+	CHECK(s.node(2) == "c");
+	CHECK(s.contains("b"));
+	CHECK(!s.contains("z"));
+	CHECK_THROWS(s.id("z"));
+
+	CHECK(s.offsets() == std::vector<std::size_t>{0, 3, 3, 4, 5});
+	CHECK(std::vector<gdwg::node_id>(s.neighbours(0).begin(), s.neighbours(0).end())
+	      == std::vector<gdwg::node_id>{1, 1, 2});
+	CHECK(std::vector<int>(s.weights(0).begin(), s.weights(0).end()) == std::vector<int>{1, 9, 2});
+	CHECK(s.degree(1) == 0);
+
+	// The snapshot does not change with the graph
+	g.clear();
+	CHECK(s.node(0) == "a");
+}
+
+/*
+The transposed snapshot holds each node's incoming edges
+*/
+TEST_CASE("csr transpose") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 2, 6);
+	g.insert_edge(3, 2, 7);
+	g.insert_edge(2, 1, 8);
+
+	auto const t = gdwg::csr(g).transpose();
+	auto const expected = gdwg::csr(g.transpose());
+	CHECK(t.offsets() == expected.offsets());
+	CHECK(t.targets() == expected.targets());
+	CHECK(t.weights() == expected.weights());
+}
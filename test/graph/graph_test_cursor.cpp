@@ -0,0 +1,78 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+
+	auto to_vector(std::vector<graph::value_type> const& page) {
+		auto ret = std::vector<std::vector<int>>{};
+		for (auto const& [from, to, weight] : page) {
+			ret.push_back({from, to, weight});
+		}
+		return ret;
+	}
+} // namespace
+
+/*
+Return the first edge after the given edge in iteration order.
+The given edge and its nodes do not need to exist.
+*/
+TEST_CASE("upper_bound") {
+	auto g = graph{1, 2, 4, 6};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 2, 7);
+	g.insert_edge(1, 4, 1);
+	g.insert_edge(4, 1, 3);
+
+	CHECK(g.upper_bound(1, 2, 5) == g.find(1, 2, 7));
+	CHECK(g.upper_bound(1, 2, 6) == g.find(1, 2, 7));
+	CHECK(g.upper_bound(1, 2, 7) == g.find(1, 4, 1));
+	CHECK(g.upper_bound(1, 3, 0) == g.find(1, 4, 1));
+
+	// Past the last edge of a node, continue at the next node with edges
+	CHECK(g.upper_bound(1, 4, 1) == g.find(4, 1, 3));
+	// src 3 is not a node
+	CHECK(g.upper_bound(3, 100, 100) == g.find(4, 1, 3));
+	CHECK(g.upper_bound(0, 0, 0) == g.begin());
+
+	CHECK(g.upper_bound(4, 1, 3) == g.end());
+	CHECK(g.upper_bound(9, 1, 3) == g.end());
+}
+
+/*
+Page through every edge, resuming each page after the last edge
+of the previous one
+*/
+TEST_CASE("edges_after") {
+	auto g = graph{};
+	for (auto i = 0; i < 20; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 20; i += 2) {
+		for (auto j = 0; j < 3; ++j) {
+			g.insert_edge(i, (i + j) % 20, j);
+		}
+	}
+
+	auto all = std::vector<graph::value_type>{};
+	for (auto page = g.first_edges(7); !page.empty();) {
+		CHECK(page.size() <= 7);
+		all.insert(all.end(), page.begin(), page.end());
+		auto const& [from, to, weight] = page.back();
+		page = g.edges_after(from, to, weight, 7);
+	}
+
+	auto expected = std::vector<graph::value_type>(g.begin(), g.end());
+	CHECK(to_vector(all) == to_vector(expected));
+
+	// The cursor still works after its edge has been erased
+	g.erase_edge(0, 1, 1);
+	CHECK(to_vector(g.edges_after(0, 1, 1, 2)) == std::vector<std::vector<int>>{{0, 2, 2}, {2, 2, 0}});
+
+	CHECK(g.edges_after(18, 18, 0, 5).size() == 1);
+	CHECK(g.edges_after(18, 19, 1, 5).empty());
+	CHECK(g.first_edges(0).empty());
+}
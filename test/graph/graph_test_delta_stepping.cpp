@@ -0,0 +1,118 @@
+#include "generators.hpp"
+
+#include "gdwg/csr.hpp"
+#include "gdwg/delta_stepping.hpp"
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+/*
+Shortest distances by delta-stepping from a single source
+*/
+TEST_CASE("delta_stepping") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 10);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("b", "d", 30);
+	g.insert_edge("c", "d", 50);
+
+	auto const r = gdwg::delta_stepping(g, std::string("a"), 5);
+	CHECK(r.distance == std::vector<int>{0, 3, 1, 33, gdwg::detail::infinity<int>()});
+	CHECK(r.path(3) == std::vector<gdwg::node_id>{0, 2, 1, 3});
+
+	CHECK_THROWS(gdwg::delta_stepping(g, std::string("z"), 5));
+	CHECK_THROWS(gdwg::delta_stepping(g, std::string("a"), 0));
+	g.insert_edge("d", "e", -1);
+	CHECK_THROWS(gdwg::delta_stepping(g, std::string("a"), 5));
+}
+
+/*
+Distances are identical to Dijkstra for any delta and thread count
+*/
+TEST_CASE("delta_stepping matches dijkstra") {
+	auto const g = gdwg::csr(gdwg::test::random_graph(2000, 12000, 7, 0.0, 100.0));
+	auto const expected = gdwg::dijkstra(g, 0);
+	for (auto const delta : {0.5, 3.0, 25.0, 1000.0}) {
+		for (auto const threads : {std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+			auto const r = gdwg::delta_stepping(g, 0, delta, threads);
+			CHECK(r.distance == expected.distance);
+			for (auto v = gdwg::node_id{1}; v < g.size(); ++v) {
+				CHECK(r.reached(v) == expected.reached(v));
+			}
+		}
+	}
+
+	auto const h = gdwg::csr(gdwg::test::random_graph(500, 4000, 7, 0L, 25L));
+	CHECK(gdwg::delta_stepping(h, 3, 4L, 4).distance == gdwg::dijkstra(h, 3).distance);
+
+	// Few distinct small weights, zero among them, tie many paths and
+	// keep nodes moving within a bucket
+	auto const ties = gdwg::csr(gdwg::test::random_graph(2000, 12000, 11, 0, 4));
+	auto const expected_ties = gdwg::dijkstra(ties, 0);
+	for (auto const delta : {1, 2, 5, 100}) {
+		for (auto const threads : {std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+			auto const r = gdwg::delta_stepping(ties, 0, delta, threads);
+			CHECK(r.distance == expected_ties.distance);
+			for (auto v = gdwg::node_id{1}; v < ties.size(); ++v) {
+				CHECK(r.reached(v) == expected_ties.reached(v));
+			}
+		}
+	}
+}
+
+/*
+Distances far beyond the largest weight wrap around the bucket ring
+many times
+*/
+TEST_CASE("delta_stepping on a long path") {
+	auto g = gdwg::graph<int, int>{};
+	auto constexpr n = 3000;
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < n; ++i) {
+		g.insert_edge(i, i + 1, 1 + i % 7);
+		if (i + 5 < n) {
+			g.insert_edge(i, i + 5, 40);
+		}
+	}
+	auto const c = gdwg::csr(g);
+	auto const expected = gdwg::dijkstra(c, 0);
+	for (auto const delta : {1, 3, 50}) {
+		for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+			auto const r = gdwg::delta_stepping(c, 0, delta, threads);
+			CHECK(r.distance == expected.distance);
+			CHECK(r.distance.back() > 100 * 7);
+		}
+	}
+}
+
+/*
+A single huge weight leaves its target far beyond the bucket ring,
+without allocating a bucket for every distance in between
+*/
+TEST_CASE("delta_stepping with a huge weight") {
+	auto g = gdwg::graph<int, long>{0, 1, 2, 3, 4};
+	g.insert_edge(0, 1, 2);
+	g.insert_edge(1, 2, 1'000'000'000'000L);
+	g.insert_edge(2, 3, 1);
+	g.insert_edge(0, 3, 2'000'000'000'000L);
+	g.insert_edge(3, 4, 500'000'000L);
+	auto const c = gdwg::csr(g);
+	for (auto const threads : {std::size_t{1}, std::size_t{3}}) {
+		auto const r = gdwg::delta_stepping(c, 0, 1L, threads);
+		CHECK(r.distance == gdwg::dijkstra(c, 0).distance);
+		CHECK(r.distance[4] == 1'000'500'000'003L);
+	}
+
+	auto h = gdwg::graph<int, double>{0, 1};
+	h.insert_edge(0, 1, 1e300);
+	CHECK_THROWS(gdwg::delta_stepping(h, 0, 1.0));
+	h.insert_edge(1, 0, std::numeric_limits<double>::infinity());
+	CHECK_THROWS(gdwg::delta_stepping(h, 0, 1e300));
+}
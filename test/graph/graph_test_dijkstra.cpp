@@ -0,0 +1,94 @@
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+Shortest distances and predecessors from a single source,
+indexed by position in nodes()
+*/
+TEST_CASE("dijkstra") {
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 4);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "b", 2);
+	g.insert_edge("b", "d", 1);
+	g.insert_edge("c", "d", 5);
+	g.insert_edge("d", "a", 1);
+
+	auto const r = gdwg::dijkstra(g, std::string("a"));
+	CHECK(r.distance == std::vector<double>{0, 3, 1, 4, gdwg::detail::infinity<double>()});
+	CHECK(r.path(3) == std::vector<gdwg::node_id>{0, 2, 1, 3});
+	CHECK(r.path(0) == std::vector<gdwg::node_id>{0});
+	CHECK(!r.reached(4));
+	CHECK(r.path(4).empty());
+
+	// Stopping at a target still gives the right distance to it
+	auto const to_b = gdwg::dijkstra(g, std::string("a"), std::string("b"));
+	CHECK(to_b.distance[1] == 3);
+	CHECK(to_b.path(1) == std::vector<gdwg::node_id>{0, 2, 1});
+
+	CHECK_THROWS(gdwg::dijkstra(g, std::string("z")));
+	CHECK_THROWS(gdwg::dijkstra(g, std::string("a"), std::string("z")));
+}
+
+/*
+Parallel edges use the cheapest weight, and negative weights are rejected
+*/
+TEST_CASE("dijkstra parallel and negative edges") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 7);
+	g.insert_edge(1, 2, 3);
+	g.insert_edge(2, 3, 1);
+	CHECK(gdwg::dijkstra(g, 1).distance == std::vector<int>{0, 3, 4});
+
+	g.insert_edge(2, 1, -1);
+	CHECK_THROWS(gdwg::dijkstra(g, 1));
+}
+
+/*
+Distances match a simple relax-until-stable reference on a larger graph
+*/
+TEST_CASE("dijkstra matches reference") {
+	auto g = gdwg::graph<int, long>{};
+	auto const n = 300;
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	auto seed = 12345UL;
+	auto next = [&seed] {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		return static_cast<int>(seed >> 33U);
+	};
+	for (auto i = 0; i < 6 * n; ++i) {
+		g.insert_edge(next() % n, next() % n, next() % 100);
+	}
+
+	auto expected = std::vector<long>(static_cast<std::size_t>(n), gdwg::detail::infinity<long>());
+	expected[0] = 0;
+	for (auto changed = true; changed;) {
+		changed = false;
+		for (auto const& [from, to, weight] : g) {
+			auto const u = static_cast<std::size_t>(from);
+			auto const v = static_cast<std::size_t>(to);
+			if (expected[u] != gdwg::detail::infinity<long>() && expected[u] + weight < expected[v]) {
+				expected[v] = expected[u] + weight;
+				changed = true;
+			}
+		}
+	}
+
+	auto const r = gdwg::dijkstra(g, 0);
+	CHECK(r.distance == expected);
+	for (auto v = gdwg::node_id{0}; v < static_cast<gdwg::node_id>(n); ++v) {
+		if (r.reached(v) && v != 0) {
+			auto const u = r.predecessor[v];
+			// Node values equal node ids here
+			auto const w = g.weights(static_cast<int>(u), static_cast<int>(v)).front();
+			CHECK(r.distance[u] + w == r.distance[v]);
+		}
+	}
+}
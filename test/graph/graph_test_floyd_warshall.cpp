@@ -0,0 +1,108 @@
+#include "gdwg/bellman_ford.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/floyd_warshall.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+/*
+Small graph with parallel edges, a self-loop and an unreachable node
+*/
+TEST_CASE("floyd_warshall on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 7);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("b", "c", -2);
+	g.insert_edge("a", "c", 4);
+	g.insert_edge("c", "c", 5);
+	g.insert_edge("c", "a", 1);
+
+	auto const d = gdwg::floyd_warshall(g);
+	auto constexpr inf = gdwg::detail::infinity<int>();
+	REQUIRE(d.size() == 4);
+	CHECK(d.data() == std::vector<int>{0, 3, 1, inf, -1, 0, -2, inf, 1, 4, 0, inf, inf, inf, inf, 0});
+	CHECK(d.reached(0, 2));
+	CHECK(!d.reached(0, 3));
+	CHECK(d.row(1)[0] == -1);
+}
+
+TEST_CASE("floyd_warshall rejects negative cycles") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(2, 3, -3);
+	g.insert_edge(3, 1, 1);
+	CHECK_THROWS_WITH(gdwg::floyd_warshall(g),
+	                  "Cannot call gdwg::floyd_warshall on a graph with a negative cycle");
+
+	auto h = gdwg::graph<int, double>{1};
+	h.insert_edge(1, 1, -0.5);
+	CHECK_THROWS(gdwg::floyd_warshall(h));
+
+	// Going round a heavy negative cycle again and again would
+	// overflow int long before the cycle is reported
+	auto big = gdwg::graph<int, int>{};
+	auto constexpr n = 150;
+	for (auto i = 0; i < n; ++i) {
+		big.insert_node(i);
+	}
+	for (auto i = 0; i < n; ++i) {
+		big.insert_edge(i, (i + 1) % n, -10'000'000);
+	}
+	CHECK_THROWS(gdwg::floyd_warshall(big));
+}
+
+/*
+Several tiles, with a size that is not a multiple of the tile side,
+checked against single-source searches from every node
+*/
+TEST_CASE("floyd_warshall matches single-source searches") {
+	auto const n = 150;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	// Shifting non-negative weights by a potential gives negative
+	// weights without negative cycles
+	auto const potential = [](int v) { return v % 7; };
+	for (auto i = 0; i < n; ++i) {
+		for (auto j = 1; j <= 3; ++j) {
+			auto const to = (i * 53 + j * 29) % n;
+			g.insert_edge(i, to, (i * j) % 23 + potential(i) - potential(to));
+		}
+	}
+	auto const s = gdwg::csr(g);
+
+	SECTION("negative weights") {
+		auto const d = gdwg::floyd_warshall(s, 3);
+		for (auto u = gdwg::node_id{0}; u < s.size(); ++u) {
+			auto const expected = gdwg::bellman_ford(s, u);
+			REQUIRE(!expected.has_negative_cycle());
+			CHECK(std::vector<int>(d.row(u).begin(), d.row(u).end()) == expected.paths.distance);
+		}
+	}
+
+	SECTION("thread counts agree") {
+		CHECK(gdwg::floyd_warshall(s, 1) == gdwg::floyd_warshall(s, 4));
+	}
+
+	SECTION("floating point weights") {
+		auto h = gdwg::graph<int, double>{};
+		for (auto const& [from, to, weight] : g) {
+			h.insert_node(from);
+			h.insert_node(to);
+			h.insert_edge(from, to, weight - potential(from) + potential(to) + 0.5);
+		}
+		auto const hs = gdwg::csr(h);
+		auto const d = gdwg::floyd_warshall(hs, 2);
+		for (auto u = gdwg::node_id{0}; u < hs.size(); ++u) {
+			auto const expected = gdwg::dijkstra(hs, u).distance;
+			for (auto v = gdwg::node_id{0}; v < hs.size(); ++v) {
+				CHECK(d(u, v) == Approx(expected[v]));
+			}
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#include "gdwg/bellman_ford.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/floyd_warshall.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/johnson.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+	// Sparse graph with negative weights but no negative cycle
+	auto sparse_graph(int n) -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		auto const potential = [](int v) { return (v * 5) % 11; };
+		for (auto i = 0; i < n; ++i) {
+			for (auto j = 1; j <= 2; ++j) {
+				auto const to = (i * 31 + j * 17) % n;
+				g.insert_edge(i, to, (i + j) % 13 + potential(i) - potential(to));
+			}
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("johnson on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("b", "c", -2);
+	g.insert_edge("a", "c", 4);
+	g.insert_edge("c", "a", 1);
+
+	auto constexpr inf = gdwg::detail::infinity<int>();
+	auto const d = gdwg::johnson(g);
+	CHECK(d.data() == std::vector<int>{0, 3, 1, inf, -1, 0, -2, inf, 1, 4, 0, inf, inf, inf, inf, 0});
+
+	g.insert_edge("c", "b", 1);
+	CHECK_THROWS_WITH(gdwg::johnson(g), "Cannot call gdwg::johnson on a graph with a negative cycle");
+}
+
+TEST_CASE("johnson matches floyd_warshall and bellman_ford") {
+	auto const s = gdwg::csr(sparse_graph(300));
+	auto const expected = gdwg::floyd_warshall(s);
+	CHECK(gdwg::johnson(s, 1) == expected);
+	CHECK(gdwg::johnson(s, 4) == expected);
+	auto const from_zero = gdwg::bellman_ford(s, 0).paths.distance;
+	CHECK(std::vector<int>(expected.row(0).begin(), expected.row(0).end()) == from_zero);
+}
+
+/*
+The sink sees every source exactly once and never needs the matrix
+*/
+TEST_CASE("johnson streams rows to a sink") {
+	auto const s = gdwg::csr(sparse_graph(120));
+	auto const expected = gdwg::floyd_warshall(s);
+	auto lock = std::mutex{};
+	auto seen = std::vector<int>(s.size(), 0);
+	auto mismatches = 0;
+	gdwg::johnson(
+	   s,
+	   [&](gdwg::node_id src, std::span<int const> distance) {
+		   auto const ok = distance.size() == s.size()
+		                   && std::equal(distance.begin(), distance.end(), expected.row(src).begin());
+		   auto const guard = std::lock_guard(lock);
+		   ++seen[src];
+		   mismatches += ok ? 0 : 1;
+	   },
+	   3);
+	CHECK(seen == std::vector<int>(s.size(), 1));
+	CHECK(mismatches == 0);
+}
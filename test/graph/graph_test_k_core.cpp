@@ -0,0 +1,104 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/k_core.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Repeatedly remove every node of degree below k, for growing k
+	auto reference(gdwg::csr<int, int> const& g, gdwg::degree_mode mode) -> std::vector<std::size_t> {
+		auto const n = g.size();
+		auto alive = std::vector<bool>(n, true);
+		auto core = std::vector<std::size_t>(n, 0);
+		auto const degree = [&](gdwg::node_id v) {
+			auto d = std::size_t{0};
+			for (auto u = gdwg::node_id{0}; u < n; ++u) {
+				if (!alive[u]) {
+					continue;
+				}
+				for (auto const w : g.neighbours(u)) {
+					if (!alive[w]) {
+						continue;
+					}
+					auto const counts_in = mode != gdwg::degree_mode::out && w == v;
+					auto const counts_out = mode != gdwg::degree_mode::in && u == v;
+					d += (counts_in ? 1 : 0) + (counts_out ? 1 : 0);
+				}
+			}
+			return d;
+		};
+		for (auto k = std::size_t{1};; ++k) {
+			auto changed = true;
+			while (changed) {
+				changed = false;
+				for (auto v = gdwg::node_id{0}; v < n; ++v) {
+					if (alive[v] && degree(v) < k) {
+						alive[v] = false;
+						changed = true;
+					}
+				}
+			}
+			auto any = false;
+			for (auto v = gdwg::node_id{0}; v < n; ++v) {
+				if (alive[v]) {
+					core[v] = k;
+					any = true;
+				}
+			}
+			if (!any) {
+				return core;
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("core_numbers on a small graph") {
+	// A 4-clique a b c d (edges one way), with e hanging off it and f alone
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	auto const clique = std::vector<std::string>{"a", "b", "c", "d"};
+	for (auto i = std::size_t{0}; i < clique.size(); ++i) {
+		for (auto j = i + 1; j < clique.size(); ++j) {
+			g.insert_edge(clique[i], clique[j], 1);
+		}
+	}
+	g.insert_edge("e", "a", 1);
+	g.insert_edge("e", "b", 1);
+
+	CHECK(gdwg::core_numbers(g) == std::vector<std::size_t>{3, 3, 3, 3, 2, 0});
+	CHECK(gdwg::parallel_core_numbers(g, gdwg::degree_mode::total, 2) == gdwg::core_numbers(g));
+	CHECK(gdwg::core_numbers(g, gdwg::degree_mode::out) == std::vector<std::size_t>(6, 0));
+
+	auto const core = gdwg::k_core(g, 3);
+	CHECK(core.nodes() == clique);
+	CHECK(core.is_connected("a", "d"));
+	CHECK(gdwg::k_core(g, 4).empty());
+}
+
+TEST_CASE("core_numbers match a reference in every mode") {
+	auto const n = 120;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < n; ++i) {
+		for (auto j = 1; j <= 1 + i % 6; ++j) {
+			g.insert_edge(i, (i * 29 + j * j * 7) % n, j);
+		}
+		// Parallel edges and self-loops count towards degrees
+		g.insert_edge(i, (i + 1) % n, 100);
+		if (i % 10 == 0) {
+			g.insert_edge(i, i, 1);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	auto const reverse = s.transpose();
+	for (auto const mode : {gdwg::degree_mode::in, gdwg::degree_mode::out, gdwg::degree_mode::total}) {
+		auto const expected = reference(s, mode);
+		CHECK(gdwg::core_numbers(s, reverse, mode) == expected);
+		CHECK(gdwg::parallel_core_numbers(s, reverse, mode, 1) == expected);
+		CHECK(gdwg::parallel_core_numbers(s, reverse, mode, 4) == expected);
+	}
+}
@@ -0,0 +1,130 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/min_cost_flow.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Weights pack capacity and cost as capacity * 100 + (cost + 50)
+	auto unpack(int w) {
+		return std::pair(w / 100, w % 100 - 50);
+	}
+
+	/*
+	Successive shortest paths with plain Bellman-Ford over an arc list,
+	sending one unit at a time
+	*/
+	auto reference(gdwg::csr<int, int> const& g, gdwg::node_id src, gdwg::node_id dst) -> std::pair<int, int> {
+		struct arc {
+			gdwg::node_id from;
+			gdwg::node_id to;
+			int capacity;
+			int cost;
+		};
+		auto arcs = std::vector<arc>{};
+		for (auto u = gdwg::node_id{0}; u < g.size(); ++u) {
+			for (auto k = std::size_t{0}; k < g.degree(u); ++k) {
+				auto const [capacity, cost] = unpack(g.weights(u)[k]);
+				arcs.push_back({u, g.neighbours(u)[k], capacity, cost});
+				arcs.push_back({g.neighbours(u)[k], u, 0, -cost});
+			}
+		}
+		auto flow = 0;
+		auto total = 0;
+		auto constexpr inf = std::numeric_limits<int>::max();
+		while (true) {
+			auto distance = std::vector<int>(g.size(), inf);
+			auto via = std::vector<std::size_t>(g.size(), arcs.size());
+			distance[src] = 0;
+			for (auto round = std::size_t{0}; round < g.size(); ++round) {
+				for (auto a = std::size_t{0}; a < arcs.size(); ++a) {
+					auto const& [from, to, capacity, cost] = arcs[a];
+					if (capacity > 0 && distance[from] != inf && distance[from] + cost < distance[to]) {
+						distance[to] = distance[from] + cost;
+						via[to] = a;
+					}
+				}
+			}
+			if (distance[dst] == inf) {
+				return {flow, total};
+			}
+			for (auto v = dst; v != src; v = arcs[via[v]].from) {
+				--arcs[via[v]].capacity;
+				++arcs[via[v] ^ 1].capacity;
+			}
+			++flow;
+			total += distance[dst];
+		}
+	}
+} // namespace
+
+TEST_CASE("min_cost_flow on a small network") {
+	auto g = gdwg::graph<std::string, std::pair<int, int>>{"s", "a", "b", "t"};
+	// (capacity, cost)
+	g.insert_edge("s", "a", {2, 1});
+	g.insert_edge("s", "b", {1, 4});
+	g.insert_edge("a", "b", {1, 1});
+	g.insert_edge("a", "t", {1, 5});
+	g.insert_edge("b", "t", {2, 1});
+	auto const identity = [](std::pair<int, int> const& w) { return w; };
+
+	auto const result = gdwg::min_cost_flow(g, std::string("s"), std::string("t"), identity);
+	CHECK(result.flow == 3);
+	CHECK(result.cost == 3 + 6 + 5);
+
+	auto const s = gdwg::csr(g);
+	auto solver = gdwg::min_cost_flow_solver(s, identity);
+	// Cheapest single unit goes s-a-b-t
+	auto const one = solver.solve(s.id("s"), s.id("t"), 1);
+	CHECK(one.flow == 1);
+	CHECK(one.cost == 3);
+	// Edges in csr order: a->b, a->t, b->t, s->a, s->b
+	CHECK(solver.flow(0) == 1);
+	CHECK(solver.flow(1) == 0);
+	CHECK(solver.flow(4) == 0);
+	// Buffers are reused and each solve starts from zero flow
+	auto const again = solver.solve(s.id("s"), s.id("t"));
+	CHECK(again.flow == result.flow);
+	CHECK(again.cost == result.cost);
+
+	CHECK_THROWS(solver.solve(0, 0));
+	CHECK_THROWS(gdwg::min_cost_flow(g, std::string("s"), std::string("x"), identity));
+}
+
+TEST_CASE("min_cost_flow matches a reference") {
+	auto random = std::mt19937(3);
+	for (auto trial = 0; trial < 60; ++trial) {
+		auto const n = 2 + trial % 12;
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < n; ++i) {
+			g.insert_node(i);
+		}
+		for (auto e = 0; e < 3 * n; ++e) {
+			auto const u = static_cast<int>(random() % n);
+			auto const v = static_cast<int>(random() % n);
+			if (u == v) {
+				continue;
+			}
+			// Shifting by a potential gives negative costs but no negative cycle
+			auto const cost = static_cast<int>(random() % 20) + u % 7 - v % 7;
+			g.insert_edge(u, v, static_cast<int>(random() % 4) * 100 + cost + 50);
+		}
+		auto const s = gdwg::csr(g);
+		auto const dst = static_cast<gdwg::node_id>(n - 1);
+		auto solver = gdwg::min_cost_flow_solver(s, unpack);
+		auto const result = solver.solve(0, dst);
+		auto const [flow, cost] = reference(s, 0, dst);
+		CHECK(result.flow == flow);
+		CHECK(result.cost == cost);
+		// Negative costs reuse the Bellman-Ford buffers on the next solve
+		auto const again = solver.solve(0, dst);
+		CHECK(again.flow == flow);
+		CHECK(again.cost == cost);
+	}
+}
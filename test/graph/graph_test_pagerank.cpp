@@ -0,0 +1,116 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/pagerank.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+	/*
+	Straightforward push-based PageRank over the graph itself,
+	running a fixed number of iterations
+	*/
+	auto reference(gdwg::graph<int, double> const& g, double damping, bool weighted, int iterations)
+	   -> std::vector<double> {
+		auto const nodes = g.nodes();
+		auto const n = static_cast<double>(nodes.size());
+		auto rank = std::vector<double>(nodes.size(), 1 / n);
+		for (auto it = 0; it < iterations; ++it) {
+			auto next = std::vector<double>(nodes.size(), 0);
+			auto dangling = 0.0;
+			for (auto u = std::size_t{0}; u < nodes.size(); ++u) {
+				auto out = 0.0;
+				for (auto const& dst : g.connections(nodes[u])) {
+					for (auto const w : g.weights(nodes[u], dst)) {
+						out += weighted ? w : 1;
+					}
+				}
+				if (out == 0) {
+					dangling += rank[u];
+					continue;
+				}
+				for (auto v = std::size_t{0}; v < nodes.size(); ++v) {
+					if (g.is_connected(nodes[u], nodes[v])) {
+						for (auto const w : g.weights(nodes[u], nodes[v])) {
+							next[v] += damping * rank[u] * (weighted ? w : 1) / out;
+						}
+					}
+				}
+			}
+			for (auto& r : next) {
+				r += (1 - damping) / n + damping * dangling / n;
+			}
+			rank = next;
+		}
+		return rank;
+	}
+
+	auto sample_graph() -> gdwg::graph<int, double> {
+		auto g = gdwg::graph<int, double>{};
+		for (auto i = 0; i < 60; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 60; ++i) {
+			// Every 7th node is left without outgoing edges
+			if (i % 7 == 3) {
+				continue;
+			}
+			for (auto j = 1; j <= 3; ++j) {
+				g.insert_edge(i, (i * 13 + j * j * 7) % 60, 1 + (i + j) % 5);
+			}
+		}
+		return g;
+	}
+} // namespace
+
+TEST_CASE("pagerank on a cycle is uniform") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("d", "a", 1);
+	auto const r = gdwg::pagerank(g);
+	CHECK(r.converged);
+	for (auto const x : r.rank) {
+		CHECK(x == Approx(0.25));
+	}
+
+	CHECK(gdwg::pagerank(gdwg::graph<int, int>{}).rank.empty());
+}
+
+TEST_CASE("pagerank matches a reference implementation") {
+	auto const g = sample_graph();
+	auto const weighted = GENERATE(false, true);
+	auto const options = gdwg::pagerank_options{weighted, 30, 3};
+	// A tolerance of 0 runs every iteration
+	auto const r = gdwg::pagerank(g, 0.85, 0, options);
+	CHECK(!r.converged);
+	CHECK(r.iterations == 30);
+	auto const expected = reference(g, 0.85, weighted, 30);
+	REQUIRE(r.rank.size() == expected.size());
+	for (auto i = std::size_t{0}; i < expected.size(); ++i) {
+		CHECK(r.rank[i] == Approx(expected[i]).epsilon(1e-9));
+	}
+	CHECK(std::accumulate(r.rank.begin(), r.rank.end(), 0.0) == Approx(1));
+}
+
+TEST_CASE("pagerank convergence reporting") {
+	auto const g = sample_graph();
+	auto const r = gdwg::pagerank(g, 0.85, 1e-10, {true, 1000, 2});
+	CHECK(r.converged);
+	CHECK(r.residual < 1e-10);
+	CHECK(r.iterations < 1000);
+
+	auto const single = gdwg::pagerank(g, 0.85, 1e-10, {true, 1000, 1});
+	CHECK(single.iterations == r.iterations);
+	for (auto i = std::size_t{0}; i < r.rank.size(); ++i) {
+		CHECK(single.rank[i] == Approx(r.rank[i]));
+	}
+
+	auto bad = gdwg::graph<int, int>{1, 2};
+	bad.insert_edge(1, 2, -1);
+	CHECK_THROWS(gdwg::pagerank(bad, 0.85, 1e-6, {true}));
+	CHECK_NOTHROW(gdwg::pagerank(bad));
+}
@@ -0,0 +1,117 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/dijkstra.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/point_to_point.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+	// A side x side grid with unit-ish weights, node r * side + c
+	auto grid(int side) {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < side * side; ++i) {
+			g.insert_node(i);
+		}
+		for (auto r = 0; r < side; ++r) {
+			for (auto c = 0; c < side; ++c) {
+				auto const u = r * side + c;
+				if (c + 1 < side) {
+					g.insert_edge(u, u + 1, 1 + (u % 3));
+					g.insert_edge(u + 1, u, 1 + (u % 5));
+				}
+				if (r + 1 < side) {
+					g.insert_edge(u, u + side, 1 + (u % 7));
+					g.insert_edge(u + side, u, 1 + (u % 2));
+				}
+			}
+		}
+		return g;
+	}
+
+	// Total weight along path, taking the first edge between each pair
+	auto path_length(gdwg::csr<int, int> const& g, std::vector<gdwg::node_id> const& path) {
+		auto length = 0;
+		for (auto i = std::size_t{1}; i < path.size(); ++i) {
+			auto const n = g.neighbours(path[i - 1]);
+			auto const k = std::find(n.begin(), n.end(), path[i]) - n.begin();
+			length += g.weights(path[i - 1])[static_cast<std::size_t>(k)];
+		}
+		return length;
+	}
+} // namespace
+
+/*
+Bidirectional search finds the same distances as a full Dijkstra,
+and its path is a valid shortest path
+*/
+TEST_CASE("bidirectional_dijkstra") {
+	auto const side = 12;
+	auto const g = gdwg::csr(grid(side));
+	auto const reverse = g.transpose();
+	auto ws = gdwg::path_workspace<int>(g.size());
+
+	for (auto const src : {gdwg::node_id{0}, gdwg::node_id{17}, gdwg::node_id{143}}) {
+		auto const full = gdwg::dijkstra(g, src);
+		for (auto dst = gdwg::node_id{0}; dst < g.size(); dst += 7) {
+			auto const d = gdwg::bidirectional_dijkstra(g, reverse, src, dst, ws);
+			CHECK(d == full.distance[dst]);
+
+			auto const path = ws.path();
+			REQUIRE(!path.empty());
+			CHECK(path.front() == src);
+			CHECK(path.back() == dst);
+			CHECK(path_length(g, path) == d);
+		}
+	}
+}
+
+/*
+Unreachable targets give infinity and an empty path
+*/
+TEST_CASE("bidirectional_dijkstra unreachable") {
+	auto g = gdwg::graph<std::string, double>{"a", "b", "c"};
+	g.insert_edge("a", "b", 1.5);
+	g.insert_edge("c", "a", 2.0);
+
+	CHECK(gdwg::bidirectional_dijkstra(g, std::string("a"), std::string("b")) == 1.5);
+	CHECK(gdwg::bidirectional_dijkstra(g, std::string("c"), std::string("b")) == 3.5);
+	CHECK(gdwg::bidirectional_dijkstra(g, std::string("a"), std::string("a")) == 0.0);
+	CHECK(gdwg::bidirectional_dijkstra(g, std::string("b"), std::string("a"))
+	      == gdwg::detail::infinity<double>());
+	CHECK_THROWS(gdwg::bidirectional_dijkstra(g, std::string("a"), std::string("z")));
+}
+
+/*
+A* with an admissible heuristic matches Dijkstra, and a zero
+heuristic degrades to plain Dijkstra
+*/
+TEST_CASE("astar") {
+	auto const side = 12;
+	auto const g = gdwg::csr(grid(side));
+	auto ws = gdwg::path_workspace<int>(g.size());
+
+	auto const src = gdwg::node_id{5};
+	auto const full = gdwg::dijkstra(g, src);
+	for (auto dst = gdwg::node_id{0}; dst < g.size(); dst += 5) {
+		// Every edge weighs at least 1, so Manhattan distance never overestimates
+		auto const manhattan = [dst](gdwg::node_id v) {
+			return std::abs(static_cast<int>(v / side) - static_cast<int>(dst / side))
+			       + std::abs(static_cast<int>(v % side) - static_cast<int>(dst % side));
+		};
+		CHECK(gdwg::astar(g, src, dst, manhattan, ws) == full.distance[dst]);
+		CHECK(ws.path().front() == src);
+		CHECK(ws.path().back() == dst);
+		CHECK(path_length(g, ws.path()) == full.distance[dst]);
+		CHECK(gdwg::astar(g, src, dst, [](gdwg::node_id) { return 0; }, ws) == full.distance[dst]);
+	}
+
+	auto h = gdwg::graph<int, int>{1, 2, 3};
+	h.insert_edge(1, 2, 4);
+	CHECK(gdwg::astar(h, 1, 2, [](int) { return 0; }) == 4);
+	CHECK(gdwg::astar(h, 1, 3, [](int) { return 0; }) == gdwg::detail::infinity<int>());
+	CHECK_THROWS(gdwg::astar(h, 1, 9, [](int) { return 0; }));
+}
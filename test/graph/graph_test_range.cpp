@@ -0,0 +1,63 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+// Copy a lazy range of nodes into a vector for comparison
+template<typename Range>
+auto collect(Range&& range) {
+	auto ret = std::vector<std::string>{};
+	for (auto const& n : range) {
+		ret.push_back(n);
+	}
+	return ret;
+}
+
+/*
+Return the nodes in [lo, hi) in ascending order, without copying them
+*/
+TEST_CASE("nodes_in_range") {
+	auto g = gdwg::graph<int, int>{9, 1, 5, 3, 7, 11};
+
+	auto range = g.nodes_in_range(3, 9);
+	CHECK(std::vector<int>(range.begin(), range.end()) == std::vector<int>{3, 5, 7});
+
+	// Bounds do not need to be nodes themselves
+	auto between = g.nodes_in_range(2, 8);
+	CHECK(std::vector<int>(between.begin(), between.end()) == std::vector<int>{3, 5, 7});
+
+	// The range refers to the stored nodes
+	CHECK(&*g.nodes_in_range(1, 2).begin() == &*g.nodes_in_range(0, 100).begin());
+
+	// Empty and reversed ranges give no nodes
+	CHECK(g.nodes_in_range(5, 5).empty());
+	CHECK(g.nodes_in_range(9, 3).empty());
+	CHECK(g.nodes_in_range(100, 200).empty());
+}
+
+/*
+Return the nodes that start with the given prefix in ascending order
+*/
+TEST_CASE("nodes_with_prefix") {
+	auto g = gdwg::graph<std::string, int>{
+	   "eu/host1/db",
+	   "eu/host1/web",
+	   "eu/host2/web",
+	   "eu",
+	   "us/host1/db",
+	   "eu/host10/db",
+	   "eux",
+	};
+
+	CHECK(collect(g.nodes_with_prefix("eu/host1/"))
+	      == std::vector<std::string>{"eu/host1/db", "eu/host1/web"});
+	CHECK(collect(g.nodes_with_prefix("eu/"))
+	      == std::vector<std::string>{"eu/host1/db", "eu/host1/web", "eu/host10/db", "eu/host2/web"});
+
+	// An empty prefix matches every node
+	CHECK(collect(g.nodes_with_prefix("")) == g.nodes());
+
+	CHECK(g.nodes_with_prefix("asia/").empty());
+	CHECK(g.nodes_with_prefix("zz").empty());
+}
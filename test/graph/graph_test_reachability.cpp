@@ -0,0 +1,93 @@
+#include "generators.hpp"
+
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/reachability.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Reachable set of every node by a search from each
+	auto naive_reachability(gdwg::csr<int, int> const& g) -> std::vector<std::vector<bool>> {
+		auto const n = g.size();
+		auto ret = std::vector<std::vector<bool>>(n, std::vector<bool>(n, false));
+		for (auto s = gdwg::node_id{0}; s < n; ++s) {
+			auto stack = std::vector<gdwg::node_id>{s};
+			ret[s][s] = true;
+			while (!stack.empty()) {
+				auto const u = stack.back();
+				stack.pop_back();
+				for (auto const v : g.neighbours(u)) {
+					if (!ret[s][v]) {
+						ret[s][v] = true;
+						stack.push_back(v);
+					}
+				}
+			}
+		}
+		return ret;
+	}
+} // namespace
+
+TEST_CASE("reachability_index on a small graph") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	// a b c form a cycle that leads to d; e leads into the cycle; f is alone
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("e", "b", 1);
+
+	auto const index = gdwg::reachability_index(g);
+	CHECK(index.size() == 6);
+	CHECK(index.num_components() == 4);
+	CHECK(index.is_reachable(0, 2));
+	CHECK(index.is_reachable(2, 0));
+	CHECK(index.is_reachable(4, 3));
+	CHECK(index.is_reachable(5, 5));
+	CHECK_FALSE(index.is_reachable(3, 0));
+	CHECK_FALSE(index.is_reachable(0, 4));
+	CHECK_FALSE(index.is_reachable(5, 0));
+	CHECK_FALSE(index.is_reachable(0, 5));
+}
+
+TEST_CASE("reachability_index matches a search from every node") {
+	// Sparse graphs are mostly acyclic, denser ones have large components
+	for (auto const edges : {60, 120, 200}) {
+		for (auto const seed : {1u, 2u}) {
+			auto const g = gdwg::csr(gdwg::test::random_graph(120, edges, seed, 0, 2));
+			auto const expected = naive_reachability(g);
+			auto const index = gdwg::reachability_index(g);
+			for (auto s = gdwg::node_id{0}; s < g.size(); ++s) {
+				for (auto t = gdwg::node_id{0}; t < g.size(); ++t) {
+					REQUIRE(index.is_reachable(s, t) == expected[s][t]);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("reachability_index labels stay small on a long path") {
+	auto g = gdwg::graph<int, int>{};
+	auto const n = 2000;
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < n; ++i) {
+		g.insert_edge(i, i + 1, 0);
+	}
+	auto const index = gdwg::reachability_index(g);
+	CHECK(index.is_reachable(0, n - 1));
+	CHECK_FALSE(index.is_reachable(n - 1, 0));
+	// A quadratic transitive closure would need millions of entries
+	CHECK(index.num_labels() < std::size_t{50} * n);
+}
+
+TEST_CASE("reachability_index on an empty graph") {
+	auto const index = gdwg::reachability_index(gdwg::graph<int, int>{});
+	CHECK(index.size() == 0);
+	CHECK(index.num_labels() == 0);
+}
@@ -0,0 +1,109 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/scc.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Same partition, whatever the component numbering
+	auto same_partition(gdwg::components const& a, gdwg::components const& b) -> bool {
+		if (a.count != b.count || a.component.size() != b.component.size()) {
+			return false;
+		}
+		auto map = std::vector<gdwg::node_id>(a.count, gdwg::no_node);
+		for (auto v = std::size_t{0}; v < a.component.size(); ++v) {
+			auto& m = map[a.component[v]];
+			if (m == gdwg::no_node) {
+				m = b.component[v];
+			}
+			if (m != b.component[v]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto sample_graph() -> gdwg::graph<std::string, int> {
+		auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f", "g", "h"};
+		g.insert_edge("a", "b", 1);
+		g.insert_edge("b", "c", 1);
+		g.insert_edge("c", "a", 1);
+		g.insert_edge("c", "d", 4);
+		g.insert_edge("b", "d", 2);
+		g.insert_edge("d", "e", 1);
+		g.insert_edge("e", "d", 1);
+		g.insert_edge("e", "f", 1);
+		g.insert_edge("g", "g", 1);
+		g.insert_edge("g", "a", 3);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("tarjan_scc numbers components topologically") {
+	auto const g = sample_graph();
+	auto const scc = gdwg::tarjan_scc(g);
+	// a b c | d e | f | g | h
+	REQUIRE(scc.count == 5);
+	auto const& c = scc.component;
+	CHECK(c[0] == c[1]);
+	CHECK(c[1] == c[2]);
+	CHECK(c[3] == c[4]);
+	CHECK(c[6] < c[0]);
+	CHECK(c[0] < c[3]);
+	CHECK(c[3] < c[5]);
+	CHECK(scc.members()[c[3]] == std::vector<gdwg::node_id>{3, 4});
+
+	CHECK(same_partition(scc, gdwg::parallel_scc(g, 2)));
+}
+
+TEST_CASE("condensation") {
+	auto const g = sample_graph();
+	auto const dag = gdwg::condensation(g);
+	auto const c = gdwg::tarjan_scc(g).component;
+	CHECK(dag.nodes() == std::vector<gdwg::node_id>{0, 1, 2, 3, 4});
+	// The two edges from {a, b, c} into {d, e} keep the cheaper weight
+	CHECK(dag.weights(c[0], c[3]) == std::vector<int>{2});
+	CHECK(dag.weights(c[6], c[0]) == std::vector<int>{3});
+	CHECK(!dag.is_connected(c[0], c[0]));
+	for (auto const& [from, to, weight] : dag) {
+		CHECK(from < to);
+	}
+}
+
+TEST_CASE("tarjan_scc on a long cycle does not recurse") {
+	auto const n = 200000;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i + 1 < n; ++i) {
+		g.insert_edge(i, i + 1, 1);
+	}
+	CHECK(gdwg::tarjan_scc(g).count == n);
+	g.insert_edge(n - 1, 0, 1);
+	CHECK(gdwg::tarjan_scc(g).count == 1);
+}
+
+TEST_CASE("parallel_scc matches tarjan_scc") {
+	auto const n = 400;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < n; ++i) {
+		// Mostly short cycles and chains between them
+		g.insert_edge(i, (i * 7 + 3) % n, 1);
+		if (i % 5 != 0) {
+			g.insert_edge(i, (i * 11 + 1) % n, 1);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	auto const expected = gdwg::tarjan_scc(s);
+	for (auto const threads : {1, 3}) {
+		auto const scc = gdwg::parallel_scc(s, s.transpose(), threads);
+		CHECK(same_partition(scc, expected));
+	}
+}
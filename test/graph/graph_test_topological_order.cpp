@@ -0,0 +1,113 @@
+#include "gdwg/acyclic_graph.hpp"
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/topological_order.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+	// Every edge of g goes forward in order
+	template<typename N, typename E>
+	auto respects(gdwg::graph<N, E> const& g, std::vector<N> const& order) -> bool {
+		auto position = std::map<N, std::size_t>{};
+		for (auto i = std::size_t{0}; i < order.size(); ++i) {
+			position[order[i]] = i;
+		}
+		if (position.size() != g.nodes().size()) {
+			return false;
+		}
+		for (auto const& [from, to, weight] : g) {
+			if (!(position[from] < position[to])) {
+				return false;
+			}
+		}
+		return true;
+	}
+} // namespace
+
+TEST_CASE("topological_order") {
+	auto g = gdwg::graph<std::string, int>{"shirt", "tie", "jacket", "belt", "pants", "shoes", "socks"};
+	g.insert_edge("shirt", "tie", 1);
+	g.insert_edge("tie", "jacket", 1);
+	g.insert_edge("shirt", "belt", 1);
+	g.insert_edge("belt", "jacket", 1);
+	g.insert_edge("pants", "belt", 1);
+	g.insert_edge("pants", "shoes", 1);
+	g.insert_edge("socks", "shoes", 1);
+	auto const order = gdwg::topological_order(g);
+	CHECK(respects(g, order));
+	CHECK(!gdwg::has_cycle(g));
+
+	g.insert_edge("jacket", "shirt", 1);
+	CHECK(gdwg::has_cycle(g));
+	CHECK_THROWS_WITH(gdwg::topological_order(g), "Cannot call gdwg::topological_order on a graph with a cycle");
+
+	auto loop = gdwg::graph<int, int>{1};
+	loop.insert_edge(1, 1, 0);
+	CHECK(gdwg::has_cycle(loop));
+}
+
+TEST_CASE("acyclic_graph rejects cycle-forming edges") {
+	auto dag = gdwg::acyclic_graph<int, int>{};
+	for (auto i = 1; i <= 5; ++i) {
+		CHECK(dag.insert_node(i));
+	}
+	CHECK(!dag.insert_node(3));
+
+	// Inserted against the initial order, so each one reorders
+	CHECK(dag.insert_edge(5, 4, 1));
+	CHECK(dag.insert_edge(4, 3, 1));
+	CHECK(dag.insert_edge(3, 1, 1));
+	CHECK(dag.precedes(5, 1));
+	CHECK(respects(dag.graph(), dag.topological_order()));
+
+	CHECK(!dag.insert_edge(1, 5, 1));
+	CHECK(!dag.insert_edge(1, 1, 1));
+	CHECK(!dag.graph().is_connected(1, 5));
+	CHECK(!dag.insert_edge(5, 4, 1));
+	CHECK(dag.insert_edge(5, 4, 2));
+	CHECK(dag.graph().weights(5, 4) == std::vector<int>{1, 2});
+
+	// Once a path is gone the reverse edge is accepted
+	CHECK(dag.erase_edge(4, 3, 1));
+	CHECK(!dag.erase_edge(4, 3, 1));
+	CHECK(dag.insert_edge(1, 4, 1));
+	CHECK(respects(dag.graph(), dag.topological_order()));
+
+	CHECK_THROWS(dag.insert_edge(1, 9, 1));
+	CHECK_THROWS(dag.precedes(9, 1));
+}
+
+/*
+Random inserts are accepted exactly when the plain graph with the
+edge added stays acyclic
+*/
+TEST_CASE("acyclic_graph agrees with a full check") {
+	auto const n = 60;
+	auto dag = gdwg::acyclic_graph<int, int>{};
+	auto reference = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		dag.insert_node(i);
+		reference.insert_node(i);
+	}
+	auto accepted = 0;
+	for (auto k = 0; k < 600; ++k) {
+		auto const src = (k * 37 + 11) % n;
+		auto const dst = (k * 53 + k / 7) % n;
+		reference.insert_edge(src, dst, k);
+		auto const acyclic = !gdwg::has_cycle(reference);
+		REQUIRE(dag.insert_edge(src, dst, k) == acyclic);
+		if (acyclic) {
+			++accepted;
+		}
+		else {
+			reference.erase_edge(src, dst, k);
+		}
+	}
+	CHECK(accepted > 50);
+	CHECK(respects(dag.graph(), dag.topological_order()));
+}
@@ -0,0 +1,62 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+/*
+Return a new graph with every edge src->dst reversed into dst->src.
+The result should equal a graph built by inserting each reversed edge.
+*/
+TEST_CASE("transpose") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 3);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("b", "a", 4);
+	g.insert_edge("c", "c", 5);
+	g.insert_edge("d", "b", 1);
+
+	auto expected = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	for (auto const& [from, to, weight] : g) {
+		expected.insert_edge(to, from, weight);
+	}
+
+	auto const t = g.transpose();
+	CHECK(t == expected);
+	CHECK(t.weights("b", "a") == std::vector<int>{1, 3});
+	CHECK(t.connections("b") == std::vector<std::string>{"a", "a", "d"});
+	CHECK(t.is_connected("c", "c"));
+	CHECK(t.connections("e").empty());
+
+	// Transposing twice gives back the original graph
+	CHECK(t.transpose() == g);
+
+	// The transpose owns its own nodes and weights
+	g.clear();
+	CHECK(t.is_connected("c", "a"));
+
+	// An empty graph transposes to an empty graph
+	CHECK(gdwg::graph<int, int>{}.transpose().empty());
+}
+
+/*
+The threaded transpose gives the same graph as the sequential one
+*/
+TEST_CASE("parallel transpose") {
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < 200; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < 200; ++i) {
+		for (auto j = 1; j <= 5; ++j) {
+			g.insert_edge(i, (i * 7 + j * 13) % 200, j);
+			g.insert_edge(i, (i * 7 + j * 13) % 200, -j);
+		}
+	}
+
+	auto const sequential = g.transpose();
+	CHECK(g.transpose(4) == sequential);
+	CHECK(g.transpose(0) == sequential);
+	CHECK(g.transpose(1000) == sequential);
+}
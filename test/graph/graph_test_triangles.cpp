@@ -0,0 +1,89 @@
+#include "gdwg/csr.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/triangles.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("triangle_count ignores direction, weights and repeats") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	// Triangle a b c, with edges in both directions and parallel weights
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "a", 2);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("b", "c", 7);
+	g.insert_edge("a", "c", 1);
+	// Triangle b c d, sharing the edge b c
+	g.insert_edge("d", "b", 1);
+	g.insert_edge("c", "d", 1);
+	// A self-loop and a pendant node
+	g.insert_edge("e", "e", 1);
+	g.insert_edge("d", "e", 1);
+
+	auto const t = gdwg::triangle_count(g);
+	CHECK(t.total == 2);
+	CHECK(t.count == std::vector<std::uint64_t>{1, 2, 2, 1, 0});
+	CHECK(t.clustering[0] == Approx(1.0));
+	// b has neighbours a c d, with a-c and c-d connected
+	CHECK(t.clustering[1] == Approx(2.0 / 3.0));
+	CHECK(t.clustering[3] == Approx(1.0 / 3.0));
+	CHECK(t.clustering[4] == 0.0);
+}
+
+TEST_CASE("triangle_count on a complete graph") {
+	auto const n = 30;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < n; ++i) {
+		for (auto j = i + 1; j < n; ++j) {
+			g.insert_edge(i, j, i * j);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	for (auto const threads : {1, 4}) {
+		auto const t = gdwg::triangle_count(s, s.transpose(), threads);
+		CHECK(t.total == n * (n - 1) * (n - 2) / 6);
+		CHECK(t.count == std::vector<std::uint64_t>(n, (n - 1) * (n - 2) / 2));
+		CHECK(t.clustering == std::vector<double>(n, 1.0));
+	}
+}
+
+TEST_CASE("triangle_count matches a naive count") {
+	auto const n = 300;
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < n; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < n; ++i) {
+		// A few hubs give skewed degrees
+		for (auto j = 1; j <= (i % 50 == 0 ? 60 : 4); ++j) {
+			g.insert_edge(i, (i * 17 + j * j * 3) % n, 1);
+		}
+	}
+	auto const s = gdwg::csr(g);
+	auto const connected = [&g](int a, int b) { return g.is_connected(a, b) || g.is_connected(b, a); };
+	auto expected = std::vector<std::uint64_t>(n, 0);
+	for (auto a = 0; a < n; ++a) {
+		for (auto b = a + 1; b < n; ++b) {
+			if (!connected(a, b)) {
+				continue;
+			}
+			for (auto c = b + 1; c < n; ++c) {
+				if (connected(a, c) && connected(b, c)) {
+					++expected[static_cast<std::size_t>(a)];
+					++expected[static_cast<std::size_t>(b)];
+					++expected[static_cast<std::size_t>(c)];
+				}
+			}
+		}
+	}
+	auto const t = gdwg::triangle_count(s, s.transpose(), 3);
+	CHECK(t.count == expected);
+	CHECK(t.total * 3 == std::accumulate(expected.begin(), expected.end(), std::uint64_t{0}));
+}
@@ -0,0 +1,122 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/views.hpp"
+
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+/*
+Iterate through every edge ordered by src, dst and weight,
+skipping nodes with no outgoing edges.
+*/
+TEST_CASE("graph iterator") {
+	auto g = gdwg::graph<int, int>{1, 7, 12, 14, 19, 21, 31};
+	g.insert_edge(1, 7, 4);
+	g.insert_edge(1, 12, 3);
+	g.insert_edge(1, 21, 12);
+	g.insert_edge(7, 21, 13);
+	g.insert_edge(12, 19, 16);
+	g.insert_edge(14, 14, 0);
+	g.insert_edge(19, 1, 3);
+	g.insert_edge(19, 21, 2);
+	g.insert_edge(21, 14, 23);
+	g.insert_edge(21, 31, 14);
+
+	auto out = std::vector<std::vector<int>>{};
+	for (auto const& [from, to, weight] : g) {
+		out.push_back({from, to, weight});
+	}
+	CHECK(out
+	      == std::vector<std::vector<int>>{{1, 7, 4},
+	                                       {1, 12, 3},
+	                                       {1, 21, 12},
+	                                       {7, 21, 13},
+	                                       {12, 19, 16},
+	                                       {14, 14, 0},
+	                                       {19, 1, 3},
+	                                       {19, 21, 2},
+	                                       {21, 14, 23},
+	                                       {21, 31, 14}});
+
+	// Walking back from end() should reach the last edge
+	auto last = g.end();
+	--last;
+	CHECK((*last).from == 21);
+	CHECK((*last).to == 31);
+
+	// find returns end() for an edge that does not exist
+	CHECK(g.find(1, 7, 4) == g.begin());
+	CHECK(g.find(1, 7, 5) == g.end());
+	CHECK(g.find(100, 7, 4) == g.end());
+
+	// An empty graph has begin() == end()
+	auto empty = gdwg::graph<int, int>{1, 2};
+	CHECK(empty.begin() == empty.end());
+}
+
+/*
+Only edges that pass the predicate are visible through a filtered view
+*/
+TEST_CASE("filtered_view") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 5);
+	g.insert_edge("a", "c", 7);
+	g.insert_edge("b", "d", 2);
+	g.insert_edge("c", "a", 9);
+
+	auto const view = gdwg::filtered_view(g, [](auto const&, auto const&, int w) { return w < 6; });
+
+	CHECK(view.nodes() == g.nodes());
+	CHECK(view.is_connected("a", "b"));
+	CHECK(!view.is_connected("a", "c"));
+	CHECK(!view.is_connected("c", "a"));
+	CHECK(view.weights("a", "b") == std::vector<int>{1, 5});
+	CHECK(view.weights("a", "c").empty());
+	CHECK(view.connections("a") == std::vector<std::string>{"b", "b"});
+	CHECK(view.connections("c").empty());
+
+	auto count = 0;
+	for (auto const& [from, to, weight] : view) {
+		CHECK(weight < 6);
+		++count;
+	}
+	CHECK(count == 3);
+
+	// The view reflects later changes to the graph
+	g.insert_edge("d", "a", 3);
+	CHECK(view.connections("d") == std::vector<std::string>{"a"});
+
+	CHECK_THROWS(view.is_connected("a", "z"));
+	CHECK_THROWS(view.weights("z", "a"));
+	CHECK_THROWS(view.connections("z"));
+}
+
+/*
+Every edge src->dst is seen as dst->src through a reverse view
+*/
+TEST_CASE("reverse_view") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(1, 2, 10);
+	g.insert_edge(1, 2, 20);
+	g.insert_edge(3, 2, 30);
+	g.insert_edge(2, 4, 40);
+
+	auto const view = gdwg::reverse_view(g);
+
+	CHECK(view.is_connected(2, 1));
+	CHECK(!view.is_connected(1, 2));
+	CHECK(view.weights(2, 1) == std::vector<int>{10, 20});
+	CHECK(view.connections(2) == std::vector<int>{1, 1, 3});
+	CHECK(view.connections(4) == std::vector<int>{2});
+	CHECK(view.connections(1).empty());
+
+	auto out = std::vector<std::vector<int>>{};
+	for (auto const& [from, to, weight] : view) {
+		out.push_back({from, to, weight});
+	}
+	CHECK(out == std::vector<std::vector<int>>{{2, 1, 10}, {2, 1, 20}, {4, 2, 40}, {2, 3, 30}});
+
+	CHECK_THROWS(view.is_connected(1, 9));
+	CHECK_THROWS(view.connections(9));
+}